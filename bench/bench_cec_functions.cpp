@@ -0,0 +1,194 @@
+/*!
+ * Throughput of the CEC-2017 functions.
+ *
+ * Every function of initialize_function (cec_all_functions.hpp) is measured
+ * on 10, 30, 50 and 100 genes, of doubles and of floats, evaluating one
+ * chromosome at a time (fitness) and a generation at a time
+ * (fitness_batch). items_per_second is the number of evaluations per second.
+ *
+ * The basic functions with transcendental terms (Weierstrass, Katsuura,
+ * Schaffer's F7, Schwefel and Lunacek bi-Rastrigin) and Rastrigin's function,
+ * their reference, are also measured as is, without shift or rotation, by
+ * evaluate, with the scalar loops and with the vector kernels
+ * (evaluate/\<function\>/D:\<D\>/isa:\<instruction set\>). They need no
+ * data.
+ *
+ * Usage: bench_cec_functions [benchmark flags] [directory of the CEC data]
+ *
+ * The directory defaults to cec-2017/ (\see README.md). The bench target
+ * runs every benchmark and writes the results to bench.json.
+ */
+
+#include <benchmark/benchmark.h>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "matrix.hpp"
+#include "rand.hpp"
+#include "simd.hpp"
+#include "problem/cec_all_functions.hpp"
+#include "problem/katsuura.hpp"
+#include "problem/lunacek_bi_rastrigin.hpp"
+#include "problem/modified_schwefel.hpp"
+#include "problem/rastrigin.hpp"
+#include "problem/schaffer_f7.hpp"
+#include "problem/weierstrass.hpp"
+
+size_t SEED = 1;
+std::string base_path = "cec-2017/";
+
+namespace {
+
+/*! Chromosomes evaluated in turn, and by fitness_batch at once */
+constexpr std::size_t population = 100;
+
+/*! The function \p num on \p D genes, or nullptr if its data are missing */
+template <class T>
+std::unique_ptr<DE::Problem::CECFunction<T>> make_function(
+    benchmark::State& state, const std::size_t num, const std::size_t D) {
+  std::unique_ptr<DE::Problem::CECFunction<T>> function;
+  try {
+    initialize_function(function, num, D);
+  } catch (const std::exception& e) {
+    state.SkipWithError(e.what());
+    return nullptr;
+  }
+  return function;
+}
+
+/*! Chromosomes drawn within the bounds of \p function */
+template <class T>
+DE::Matrix<T> make_population(const DE::Problem::CECFunction<T>& function) {
+  DE::Matrix<T> x(population, function.get_number_of_genes());
+  function.randomize_batch(x);
+  return x;
+}
+
+template <class T>
+void fitness(benchmark::State& state, const std::size_t num,
+             const std::size_t D) {
+  const auto function = make_function<T>(state, num, D);
+  if (!function)
+    return;
+  const auto x = make_population(*function);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(function->fitness(x[i]));
+    i = i + 1 == population ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class T>
+void fitness_batch(benchmark::State& state, const std::size_t num,
+                   const std::size_t D) {
+  const auto function = make_function<T>(state, num, D);
+  if (!function)
+    return;
+  const auto x = make_population(*function);
+  std::vector<double> values(population);
+  for (auto _ : state) {
+    function->fitness_batch(x, values.data());
+    benchmark::DoNotOptimize(values.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * population);
+}
+
+/*! The basic function \p F on \p D genes, evaluated as is */
+template <template <class> class F>
+std::unique_ptr<DE::Problem::CECFunction<double>> make_basic(
+    const std::size_t D) {
+  return std::make_unique<F<double>>(D);
+}
+
+std::unique_ptr<DE::Problem::CECFunction<double>> make_lunacek(
+    const std::size_t D) {
+  return std::make_unique<DE::Problem::LunacekBiRastriginFunction<double>>(
+      D, false);
+}
+
+using BasicFactory =
+    std::unique_ptr<DE::Problem::CECFunction<double>> (*)(std::size_t);
+
+/*!
+ * \brief One evaluation of a basic function, with the instruction set \p isa
+ *
+ * The genes are drawn where the CEC functions evaluate them, from
+ * [-100, 100] scaled by the scale factor of the function.
+ */
+
+void evaluate(benchmark::State& state, const BasicFactory factory,
+              const std::size_t D, const DE::SIMD::InstructionSet isa) {
+  const auto function = factory(D);
+  DE::Matrix<double> x(population, D);
+  for (std::size_t i = 0; i < population; ++i)
+    for (std::size_t j = 0; j < D; ++j)
+      x[i][j] = rand_uniform_real(-100.0, 100.0) * function->get_scale_factor();
+  const auto previous = DE::SIMD::instruction_set();
+  DE::SIMD::set_instruction_set(isa);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(function->evaluate(x[i]));
+    i = i + 1 == population ? 0 : i + 1;
+  }
+  DE::SIMD::set_instruction_set(previous);
+  state.SetItemsProcessed(state.iterations());
+}
+
+/*! \brief Register the basic functions, named as above */
+void register_basic_benchmarks() {
+  const std::pair<const char*, BasicFactory> functions[] = {
+      {"Rastrigin", &make_basic<DE::Problem::RastriginFunction>},
+      {"Weierstrass", &make_basic<DE::Problem::WeierstrassFunction>},
+      {"Katsuura", &make_basic<DE::Problem::KatsuuraFunction>},
+      {"SchafferF7", &make_basic<DE::Problem::SchafferF7Function>},
+      {"Schwefel", &make_basic<DE::Problem::SchwefelFunction>},
+      {"LunacekBiRastrigin", &make_lunacek}};
+  for (const auto isa : {DE::SIMD::InstructionSet::scalar,
+                         DE::SIMD::detect_instruction_set()})
+    for (const auto& function : functions)
+      for (const std::size_t D : {10, 30, 50, 100}) {
+        const std::string name = std::string("evaluate/") + function.first +
+                                 "/D:" + std::to_string(D) +
+                                 "/isa:" + DE::SIMD::name(isa);
+        benchmark::RegisterBenchmark(name.c_str(), &evaluate, function.second,
+                                     D, isa);
+      }
+}
+
+/*!
+ * \brief Register every function and dimension, named
+ *        \<evaluation\>\<\p type\>/F\<num\>/D:\<D\>
+ */
+
+template <class T>
+void register_benchmarks(const std::string& type) {
+  for (std::size_t num = 1; num <= 30; ++num)
+    for (const std::size_t D : {10, 30, 50, 100}) {
+      const std::string name =
+          "<" + type + ">/F" + std::to_string(num) + "/D:" + std::to_string(D);
+      benchmark::RegisterBenchmark(("fitness" + name).c_str(), &fitness<T>,
+                                   num, D);
+      benchmark::RegisterBenchmark(("fitness_batch" + name).c_str(),
+                                   &fitness_batch<T>, num, D);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (argc > 1) {
+    base_path = argv[1];
+    if (base_path.back() != '/')
+      base_path += '/';
+  }
+  register_benchmarks<double>("double");
+  register_benchmarks<float>("float");
+  register_basic_benchmarks();
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+}
@@ -0,0 +1,151 @@
+/*!
+ * Overhead of the algorithms, outside the fitness function.
+ *
+ * SHADE, L-SHADE and DEGL optimize a stub whose fitness is the sum of the
+ * genes, next to nothing compared to the work of the algorithms on a trial,
+ * for 10, 30, 50 and 100 genes (the population follows from them: 18 D
+ * chromosomes for SHADE, 10 D for DEGL) and 1, 2, 4 and 8 threads. Every
+ * iteration evolves a new optimizer for 50 generations, and the nanoseconds
+ * per trial (ns_per_trial) and generations per second are reported; the
+ * scaling with the threads is the ratio of these across the rows.
+ *
+ * Built with DE_PROFILE_PHASES (the _PHASES executable), the time spent in
+ * each phase of the algorithms (\see Phase) is reported as well, as a share
+ * of the time of the generations (summed over the threads, hence it may
+ * exceed 1 with several threads). The timers cost some tens of nanoseconds
+ * per phase.
+ *
+ * The _telemetry rows are the same with an AsyncObserver set on the
+ * optimizers (\see telemetry.hpp), whose sink only counts the records; the
+ * cost of the telemetry is their ratio to the rows without it.
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include "algorithm/degl.hpp"
+#include "algorithm/shade.hpp"
+#include "executor.hpp"
+#include "profiler.hpp"
+#include "telemetry.hpp"
+#include "timer.hpp"
+#include "problem/simple_problem.hpp"
+
+size_t SEED = 1;
+
+namespace {
+
+/*! Generations evolved by every iteration */
+constexpr std::size_t generations = 50;
+
+/*! Sum of the genes within [-100, 100], counting the chromosomes evaluated */
+class Stub : public DE::Problem::SimpleFitnessFunction<double> {
+ public:
+  explicit Stub(const std::size_t D) : SimpleFitnessFunction<double>(D, "Stub") {
+    set_bounds(-100, 100);
+  }
+
+  double fitness(DE::ConstRowView<double> x) const {
+    evaluations_.fetch_add(1, std::memory_order_relaxed);
+    return sum(x);
+  }
+
+  void fitness_batch(DE::ConstBlockView<double> x, double* fitness) const {
+    evaluations_.fetch_add(x.rows(), std::memory_order_relaxed);
+    for (std::size_t i = 0; i < x.rows(); ++i)
+      fitness[i] = sum(x[i]);
+  }
+
+  std::size_t evaluations() const { return evaluations_.load(); }
+
+ private:
+  mutable std::atomic<std::size_t> evaluations_{0};
+
+  static double sum(DE::ConstRowView<double> x) {
+    double s = 0.0;
+    for (const auto v : x)
+      s += v;
+    return s;
+  }
+};
+
+enum class Algorithm { shade, lshade, degl };
+
+std::unique_ptr<DE::Algorithm::Base<double>> make_optimizer(
+    const Algorithm algorithm, std::shared_ptr<Stub> stub,
+    std::shared_ptr<DE::Executor> executor) {
+  switch (algorithm) {
+    case Algorithm::shade:
+      return std::make_unique<DE::Algorithm::SHADE<double>>(stub, false, true,
+                                                            executor);
+    case Algorithm::lshade:
+      return std::make_unique<DE::Algorithm::SHADE<double>>(stub, true, true,
+                                                            executor);
+    default:
+      return std::make_unique<DE::Algorithm::DEGL<double>>(stub, true,
+                                                           executor);
+  }
+}
+
+void overhead(benchmark::State& state,
+              const Algorithm algorithm,
+              const bool telemetry = false) {
+  const std::size_t D = state.range(0), threads = state.range(1);
+  const auto executor =
+      threads > 1 ? std::shared_ptr<DE::Executor>(
+                        std::make_shared<DE::ThreadPoolExecutor>(threads))
+                  : std::shared_ptr<DE::Executor>(
+                        std::make_shared<DE::SerialExecutor>());
+  std::size_t records = 0;
+  const auto observer =
+      telemetry ? std::make_shared<DE::AsyncObserver>(
+                      [&records](const DE::GenerationRecord&) { ++records; })
+                : nullptr;
+  std::size_t trials = 0;
+  double seconds = 0.0;
+  DE::PhaseProfiler::reset();
+  for (auto _ : state) {
+    state.PauseTiming();
+    const auto stub = std::make_shared<Stub>(D);
+    const auto optimizer = make_optimizer(algorithm, stub, executor);
+    optimizer->set_observer(observer);
+    const std::size_t initial = stub->evaluations();
+    state.ResumeTiming();
+    Timer t;
+    optimizer->evolve_population(generations);
+    seconds += t.elapsed().count() * 1e-9;
+    trials += stub->evaluations() - initial;
+  }
+  state.counters["N"] = (algorithm == Algorithm::degl ? 10 : 18) * D;
+  state.counters["ns_per_trial"] = 1e9 * seconds / trials;
+  state.counters["generations_per_second"] =
+      state.iterations() * generations / seconds;
+#ifdef DE_PROFILE_PHASES
+  const auto totals = DE::PhaseProfiler::totals();
+  for (std::size_t p = 0; p < DE::number_of_phases; ++p)
+    if (totals.calls[p] > 0)
+      state.counters[std::string("share_") + DE::name(DE::Phase(p))] =
+          totals.nanoseconds[p] * 1e-9 / seconds;
+#endif
+}
+
+void grid(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"D", "threads"});
+  for (const int D : {10, 30, 50, 100})
+    for (const int threads : {1, 2, 4, 8})
+      b->Args({D, threads});
+  b->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+BENCHMARK_CAPTURE(overhead, SHADE, Algorithm::shade)->Apply(grid);
+BENCHMARK_CAPTURE(overhead, L-SHADE, Algorithm::lshade)->Apply(grid);
+BENCHMARK_CAPTURE(overhead, DEGL, Algorithm::degl)->Apply(grid);
+BENCHMARK_CAPTURE(overhead, SHADE_telemetry, Algorithm::shade, true)
+    ->Apply(grid);
+BENCHMARK_CAPTURE(overhead, DEGL_telemetry, Algorithm::degl, true)
+    ->Apply(grid);
+
+}  // namespace
+
+BENCHMARK_MAIN();
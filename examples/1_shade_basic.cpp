@@ -4,10 +4,14 @@
  * First a problem and an algorithm are selected (here Griewank's function and
  * SHADE / L-SHADE respectively). The algorithms are ran, timed and the results
  * are presented in the standard output.
+ *
+ * Built with -DPROFILE_PHASES=ON, the time spent in every phase of the
+ * algorithms is presented as well.
  */
 
 #include "problem/griewank.hpp"
 #include "algorithm/shade.hpp"
+#include "profiler.hpp"
 #include "timer.hpp"
 #include <iostream>
 
@@ -19,23 +23,31 @@ int main() {
   {
     std::cout << "50-dimensional Griewank function with SHADE" << std::endl;
     Timer t;
-    f = std::make_unique<DE::Problem::GriewankFunction>(D);
+    DE::ProfiledRun profile;
+    f = std::make_unique<DE::Problem::GriewankFunction<double>>(D);
     DE::Algorithm::SHADE<double> shade(std::move(f), false);  // SHADE
     shade.evolve_population();
     auto solution = shade.get_best();
     std::chrono::duration<double> elapsed_seconds = t.elapsed();
     std::cout << "Best fitness: " << solution.best_fitness << std::endl;
     std::cout << "Seconds elapsed: " << elapsed_seconds.count() << std::endl;
+#ifdef DE_PROFILE_PHASES
+    profile.summary().write_table(std::cout);
+#endif
   }
   {
     std::cout << "50-dimensional Griewank function with L-SHADE" << std::endl;
     Timer t;
-    f = std::make_unique<DE::Problem::GriewankFunction>(D);
+    DE::ProfiledRun profile;
+    f = std::make_unique<DE::Problem::GriewankFunction<double>>(D);
     DE::Algorithm::SHADE<double> shade(std::move(f), true);  // L-SHADE
     shade.evolve_population();
     auto solution = shade.get_best();
     std::chrono::duration<double> elapsed_seconds = t.elapsed();
     std::cout << "Best fitness: " << solution.best_fitness << std::endl;
     std::cout << "Seconds elapsed: " << elapsed_seconds.count() << std::endl;
+#ifdef DE_PROFILE_PHASES
+    profile.summary().write_table(std::cout);
+#endif
   }
 }
@@ -18,7 +18,7 @@ int main() {
   constexpr std::size_t D = 10;
   std::unique_ptr<DE::Problem::Base<double>> f;
   Timer t;
-  f = std::make_unique<DE::Problem::HybridFunction1>(D);
+  f = std::make_unique<DE::Problem::HybridFunction1<double>>(D);
   DE::Algorithm::DEGL<double> degl(std::move(f), true);
   degl.evolve_population();
   auto solution = degl.get_best();
@@ -43,7 +43,11 @@ int main() {
         initialize_function(f, func, D);
         if (D == 10 && run == 0)
           file_out << f->get_name() << ",";
-        DE::Algorithm::SHADE<double> shade(std::move(f), true);  // L-SHADE
+        // L-SHADE; the run index selects the random streams of the run
+        DE::Algorithm::SHADE<double> shade(std::move(f), true, true, nullptr,
+                                           run);
+        // The budget of the CEC-2017 benchmark
+        shade.set_max_evaluations(10000 * D);
         shade.evolve_population(5e10);
         auto solution = shade.get_best();
         results.push_back(solution.best_fitness);
@@ -12,6 +12,10 @@
  *
  * This example uses L-SHADE and runs all experiments; it further accumulates
  * the results and writes them out to a csv file.
+ *
+ * Every run creates its own function, yet the shift, rotation and shuffle
+ * data of a function and dimension are loaded only by the first run to need
+ * them and shared read-only by all the others (see CECDataRegistry).
  */
 
 #include <fstream>
@@ -85,10 +89,15 @@ int main(int argc, char** argv) {
     for (const auto& D : {10}) {  //, 30, 50, 100}) {
       for (std::size_t run = 0; run < 52; ++run) {
         results.emplace_back(pool.enqueue([func, D, run] {
+          // Cheap: the data are shared with the other runs
           std::unique_ptr<DE::Problem::CECFunction<double>> f;
           initialize_function(f, func, D);
           auto name = f->get_name();
-          DE::Algorithm::SHADE<double> shade(std::move(f), true);  // L-SHADE
+          // L-SHADE; the run index selects the random streams of the run
+          DE::Algorithm::SHADE<double> shade(std::move(f), true, true, nullptr,
+                                             run);
+          // The budget of the CEC-2017 benchmark
+          shade.set_max_evaluations(10000 * D);
           shade.evolve_population(5e8);
           auto solution = shade.get_best();
           return ResultsOneRun(name, func, D, run, solution.best_fitness);
@@ -12,8 +12,19 @@
 #include <cstddef>
 #include <algorithm>
 #include <assert.h>
+#include <cmath>
 #include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include "dimension.hpp"
+#include "executor.hpp"
+#include "matrix.hpp"
 #include "problem/base_problem.hpp"
+#include "profiler.hpp"
+#include "rand.hpp"
+#include "telemetry.hpp"
+#include "timer.hpp"
 
 namespace DE {
 
@@ -40,23 +51,32 @@ class Base {
    * \param problem  : Pointer to a Base Problem
    * \param N        : Number of chromosomes
    * \param minimize : If true, minimize the fitness function
+   * \param executor : If given, parallel computations (including the
+   *                   evaluation of the initial population) run on it
+   * \param run      : Index of the run, selects its random streams; if not
+   *                   given, runs are numbered in order of construction
    */
 
   Base(std::shared_ptr<Problem::Base<T>> problem,
        const std::size_t N,
-       const bool minimize)
+       const bool minimize,
+       std::shared_ptr<Executor> executor = nullptr,
+       const std::size_t run = next_run())
       : p_problem_(problem),
         D_(p_problem_->get_number_of_genes()),
         N_(N),
         minimize_(minimize),
-        allow_parallel_(false) {
+        x_(N_, D_),
+        trials_(N_, D_),
+        executor_(executor ? std::move(executor)
+                           : std::make_shared<SerialExecutor>()),
+        allow_parallel_(executor_->num_threads() > 1),
+        seed_(SEED),
+        run_(run),
+        generation_(0) {
     fit_.resize(N_);
-    std::vector<T> initial_chromosome(D_, 0);
-    x_.resize(N_, initial_chromosome);
-    for (std::size_t i = 0; i < N_; ++i) {
-      p_problem_->randomize(x_[i]);
-      fit_[i] = p_problem_->fitness(x_[i]);
-    }
+    trial_fit_.resize(N_);
+    initialize_population(0);
   };
 
   /*!
@@ -66,25 +86,38 @@ class Base {
    * \param initial_chromosome : An initial (ideally not random) solution
    * \param N                  : Number of chromosomes
    * \param minimize           : If true, minimize the fitness function
+   * \param executor           : If given, parallel computations (including
+   *                             the evaluation of the initial population)
+   *                             run on it
+   * \param run                : Index of the run, selects its random
+   *                             streams; if not given, runs are numbered in
+   *                             order of construction
    */
 
   Base(std::shared_ptr<Problem::Base<T>> problem,
        const std::vector<T>& initial_chromosome,
        const std::size_t N,
-       const bool minimize)
+       const bool minimize,
+       std::shared_ptr<Executor> executor = nullptr,
+       const std::size_t run = next_run())
       : p_problem_(problem),
         D_(p_problem_->get_number_of_genes()),
         N_(N),
         minimize_(minimize),
-        allow_parallel_(false) {
+        x_(N_, D_),
+        trials_(N_, D_),
+        executor_(executor ? std::move(executor)
+                           : std::make_shared<SerialExecutor>()),
+        allow_parallel_(executor_->num_threads() > 1),
+        seed_(SEED),
+        run_(run),
+        generation_(0) {
     assert(initial_chromosome.size() == D_);
-    x_.resize(N_, initial_chromosome);
+    std::copy(initial_chromosome.begin(), initial_chromosome.end(),
+              x_[0].begin());
     fit_.resize(N_);
-    fit_[0] = p_problem_->fitness(x_[0]);
-    for (std::size_t i = 1; i < N_; ++i) {
-      p_problem_->randomize(x_[i]);
-      fit_[i] = p_problem_->fitness(x_[i]);
-    }
+    trial_fit_.resize(N_);
+    initialize_population(1);
   };
 
   /*!
@@ -102,8 +135,8 @@ class Base {
   struct Results {
     std::vector<T> best_chromosome; /*!< Best result */
     double best_fitness;            /*!< Best fitness */
-    Results(const std::vector<T>& c, const double f)
-        : best_chromosome(c), best_fitness(f){};
+    Results(ConstRowView<T> c, const double f)
+        : best_chromosome(c.begin(), c.end()), best_fitness(f){};
   };
 
   /*!
@@ -120,10 +153,59 @@ class Base {
   /*!
    * \brief Enables parallel (multi-thread) processing
    *
-   * Call this function after the constructor to enable parallel computations
+   * Call this function after the constructor to enable parallel computations.
+   * If no multi-threaded executor was given at construction, a thread pool
+   * with one thread per hardware thread is started. The initial population
+   * has already been evaluated by then; pass an executor to the constructor
+   * to evaluate it in parallel as well.
    */
 
-  void allow_parallel_computations() { allow_parallel_ = true; }
+  void allow_parallel_computations() {
+    if (executor_->num_threads() <= 1)
+      executor_ = make_default_executor();
+    allow_parallel_ = true;
+  }
+
+  /*!
+   * \brief Get the executor running the parallel computations
+   */
+
+  Executor& get_executor() const { return *executor_; }
+
+  /*!
+   * \brief Limit the number of evaluations of the fitness function
+   *
+   * The initial population is always evaluated in full, by the
+   * constructor, before the limit can be set; its evaluations count
+   * towards the limit. From then on a generation only evaluates the trials
+   * that remain within the limit, the first ones whatever the executor, and
+   * evolve_population returns once the limit is reached. Hence a limit of
+   * at least the size of the population is met exactly, while a smaller one
+   * is exceeded by the initial population and no generation runs.
+   *
+   * \param max_evaluations : The limit; 0 (the default) means no limit
+   */
+
+  void set_max_evaluations(const std::size_t max_evaluations) {
+    max_evaluations_ = max_evaluations;
+  }
+
+  /*! Number of evaluations of the fitness function so far */
+  std::size_t get_evaluations() const { return evaluations_; }
+
+  /*!
+   * \brief Report the state of the optimizer after every generation
+   *
+   * The record (\see GenerationRecord) is only computed while an observer
+   * is set, at a cost linear in the size of the population.
+   *
+   * \param observer : Called at the end of every generation; nullptr (the
+   *                   default) to stop reporting
+   */
+
+  void set_observer(std::shared_ptr<GenerationObserver> observer) {
+    observer_ = std::move(observer);
+  }
 
  protected:
   /*! Class containing the fitness function to be optimized */
@@ -131,9 +213,22 @@ class Base {
   const std::size_t D_;           /*!< Genes (dimensions of each chromosome) */
   const std::size_t N_;           /*!< Number of initial chromosomes */
   const bool minimize_;           /*!< If true, minimize the fitness function */
-  std::vector<std::vector<T>> x_; /*!< Chromosome population (N_, D_) */
+  Matrix<T> x_;                   /*!< Chromosome population (N_, D_) */
+  Matrix<T> trials_;              /*!< Trial vector of every chromosome */
   std::vector<double> fit_;       /*!< Fitness of each solution (N_) */
+  std::vector<double> trial_fit_; /*!< Fitness of each trial vector (N_) */
+  /*! Runs the parallel computations */
+  std::shared_ptr<Executor> executor_;
   bool allow_parallel_;           /*!< True to enable parallel computations */
+  const std::uint64_t seed_;      /*!< SEED at construction */
+  const std::size_t run_;         /*!< Index of the run */
+  std::size_t generation_;        /*!< Generations evolved so far */
+  std::size_t evaluations_ = 0;   /*!< Evaluations of the fitness so far */
+  /*! Limit of the evaluations, 0 for none (\see set_max_evaluations) */
+  std::size_t max_evaluations_ = 0;
+  /*! Receives the state after every generation, if set */
+  std::shared_ptr<GenerationObserver> observer_;
+  Timer timer_;                   /*!< Started at construction */
 
   /*!
    * \brief Ascertain if rhs fitness isn't worse than lhs
@@ -162,6 +257,129 @@ class Base {
     return minimize_ ? lhs > rhs : lhs < rhs;
   }
 
+  /*!
+   * \brief Key of a random stream of the current generation
+   *
+   * Bind it with ScopedRandomStream while working on \p individual, so that
+   * the results do not depend on the executor.
+   *
+   * \param individual : Index of the individual
+   * \param purpose    : What the random numbers are used for
+   */
+
+  RandomStreamKey stream_key(const std::size_t individual,
+                             const RandomPurpose purpose) const {
+    return {seed_, std::uint32_t(run_), std::uint32_t(generation_),
+            std::uint32_t(individual), purpose};
+  }
+
+  /*!
+   * \brief Randomize and evaluate the initial population
+   *
+   * Runs in chunks on the executor, like the generations.
+   *
+   * \param first_random : Chromosomes before this index are kept as they are
+   *                       and only evaluated
+   */
+
+  void initialize_population(const std::size_t first_random) {
+    executor_->parallel_for(N_, [this, first_random](const std::size_t begin,
+                                                     const std::size_t end) {
+      for (std::size_t i = std::max(begin, first_random); i < end; ++i) {
+        ScopedRandomStream stream(
+            stream_key(i, RandomPurpose::initialization));
+        p_problem_->randomize(x_[i]);
+      }
+      DE_PROFILE_PHASE(evaluation);
+      p_problem_->fitness_batch(ConstBlockView<T>(x_).slice(begin, end - begin),
+                                fit_.data() + begin);
+    });
+    evaluations_ += N_;
+  }
+
+  /*!
+   * \brief Number of the \p n trials of a generation within the limit of
+   *        evaluations (\see set_max_evaluations)
+   */
+
+  std::size_t trials_within_limit(const std::size_t n) const {
+    if (max_evaluations_ == 0)
+      return n;
+    return evaluations_ < max_evaluations_
+               ? std::min(n, max_evaluations_ - evaluations_)
+               : 0;
+  }
+
+  /*! True once the limit of evaluations is reached */
+  bool evaluations_exhausted() const {
+    return max_evaluations_ != 0 && evaluations_ >= max_evaluations_;
+  }
+
+  /*!
+   * \brief Evaluate the trial vectors [begin, end) at once
+   *
+   * The fitness of trials_[i] is stored in trial_fit_[i].
+   *
+   * \param begin : Index of the first trial
+   * \param end   : One past the index of the last trial
+   */
+
+  void evaluate_trials(const std::size_t begin, const std::size_t end) {
+    assert(trial_fit_.size() == trials_.rows());
+    assert(begin <= end && end <= trials_.rows());
+    DE_PROFILE_PHASE(evaluation);
+    p_problem_->fitness_batch(
+        ConstBlockView<T>(trials_).slice(begin, end - begin),
+        trial_fit_.data() + begin);
+  }
+
+  /*!
+   * \brief The part of the record of the generation common to all the
+   *        algorithms (\see set_observer)
+   *
+   * The size of the population is that of fit_, which may have shrunk.
+   *
+   * \param successes : Trials of the generation strictly better than their
+   *                    parents
+   */
+
+  GenerationRecord generation_record(const std::size_t successes) const {
+    const std::size_t N = fit_.size(), best = best_index();
+    GenerationRecord record;
+    record.run = run_;
+    record.generation = generation_;
+    record.evaluations = evaluations_;
+    record.population_size = N;
+    record.successes = successes;
+    record.best_fitness = fit_[best];
+    record.mean_fitness = std::accumulate(fit_.begin(), fit_.end(), 0.0) / N;
+    // One pass over the population, with the genes taken relative to the
+    // best chromosome: the sums are then of the order of the spread itself,
+    // which does not vanish in rounding as the population converges
+    const T* reference = x_[best].data();
+    record.diversity = with_dimension(D_, [&](const auto D) {
+      GeneBuffer<double, std::decay_t<decltype(D)>> sum_buffer(D),
+          square_buffer(D);
+      double *sums = sum_buffer.data(), *squares = square_buffer.data();
+      std::fill_n(sums, D, 0.0);
+      std::fill_n(squares, D, 0.0);
+      for (std::size_t i = 0; i < N; ++i) {
+        const T* x = x_[i].data();
+        for (std::size_t j = 0; j < D; ++j) {
+          const double d = double(x[j]) - reference[j];
+          sums[j] += d;
+          squares[j] += d * d;
+        }
+      }
+      double total = 0.0;
+      for (std::size_t j = 0; j < D; ++j)
+        total += squares[j] - sums[j] * sums[j] / N;
+      return std::sqrt(std::max(total, 0.0) / N);
+    });
+    record.elapsed_seconds = timer_.elapsed().count() * 1e-9;
+    return record;
+  }
+
   /*!
    * \brief Find the best individual in the population
    *
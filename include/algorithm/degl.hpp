@@ -48,20 +48,29 @@ class DEGL : public Base<T> {
    * \param problem            : Pointer to a Base Problem
    * \param initial_chromosome : An initial (ideally not random) solution
    * \param minimize           : If true, minimize the fitness function
+   * \param executor           : If given, run parallel computations on it
+   * \param run                : Index of the run (\see Base)
    */
 
   DEGL(std::shared_ptr<Problem::Base<T>> problem,
        const std::vector<T>& initial_chromosome,
-       const bool minimize = true);
+       const bool minimize = true,
+       std::shared_ptr<Executor> executor = nullptr,
+       const std::size_t run = next_run());
 
   /*!
    * \brief Create a new optimizer with no a priori knowledge
    *
    * \param problem  : Pointer to a Base Problem
    * \param minimize : If true, minimize the fitness function
+   * \param executor : If given, run parallel computations on it
+   * \param run      : Index of the run (\see Base)
    */
 
-  DEGL(std::shared_ptr<Problem::Base<T>> problem, const bool minimize = true);
+  DEGL(std::shared_ptr<Problem::Base<T>> problem,
+       const bool minimize = true,
+       std::shared_ptr<Executor> executor = nullptr,
+       const std::size_t run = next_run());
 
   /*!
    * \brief Apply DEGL
@@ -79,69 +88,81 @@ class DEGL : public Base<T> {
   const std::size_t k_;            /*!< Neighborhood size */
   std::vector<float> w_;           /*!< Weight for every solution [N_] */
   std::vector<float> w_mutated_;   /*!< Mutated weight parameters [N_] */
+  /*! Two local and two global donors of each trial [N_] */
+  std::vector<std::array<std::size_t, 4>> donors_;
+  std::vector<std::uint32_t> random_bits_; /*!< Random bits [4 N_] */
 
   /*!
-   * \brief Initialize the weights
+   * \brief Generate and evaluate the trials of a chunk of chromosomes
+   *
+   * Only trials_, trial_fit_ and w_mutated_ of the chunk are written; the
+   * population, its fitness and the weights are only read. Hence chunks may
+   * run concurrently on the executor.
+   *
+   * \param begin       : Index of the first chromosome
+   * \param end         : One past the index of the last chromosome
+   * \param global_best : Index of the best chromosome of the generation
    */
 
-  void initialize_weights();
+  void generate_trials(const std::size_t begin,
+                       const std::size_t end,
+                       const std::size_t global_best);
 
   /*!
-   * Ring topology; find which indexes are within the neighborhood of a given
-   * index.
-   *
-   * \param index  : The current position
-   *
-   * \return A vector with all the valid indexes
+   * \brief Initialize the weights
    */
 
-  std::vector<std::size_t> get_neighborhood_indexes(
-      const std::size_t index) const;
+  void initialize_weights();
 
   /*!
-   * Ring topology; get random indexes from within a neighborhood
+   * Ring topology; find the n-th index within the neighborhood of a given
+   * index. The first k_ neighbors lie forward, the next k_ backwards.
    *
-   * \param places  : The vector from get_valid_indexes
+   * \param index : The current position
+   * \param n     : Which neighbor, in [0, 2 k_)
    *
-   * \return An array with two random indexes.
+   * \return The index of the neighbor
    */
 
-  std::array<std::size_t, 2> get_random_local_indexes(
-      const std::vector<std::size_t>& places) const;
+  std::size_t get_neighbor(const std::size_t index, const std::size_t n) const;
 
   /*!
-   * \brief Get two random different indexes from [0, N_ - 1].
-   *
-   * Furthermore, they should be different from \param avoid
+   * \brief Draw the random donors of every trial of the generation
    *
-   * \param avoid : the index to avoid
+   * The bits of all trials are drawn in bulk from one stream of the
+   * generation. Two distinct neighbors (ring topology) and two distinct
+   * chromosomes other than the trial's own are stored in donors_, with no
+   * rejection sampling.
    */
 
-  std::array<std::size_t, 2> get_random_global_indexes(
-      const std::size_t avoid) const;
+  void draw_parameters();
 
   /*!
    * Find the best from within a neighborhood.
    *
-   * \param places : Vector with valid places (get_valid_indexes)
+   * \param index : The current position
    *
    * \return The position of the local best
    */
 
-  std::size_t find_local_best(const std::vector<std::size_t>& places) const;
+  std::size_t find_local_best(const std::size_t index) const;
 
   /*!
    * Mutation in DEGL [Das, et. al].
    *
-   * Mutation as described in DEGL. Get 2 random local indexes and 2 global
-   * indexes. Find the local best (global best is passed from outside).
+   * Mutation as described in DEGL. The 2 random local indexes and 2 global
+   * indexes are read from donors_. Find the local best (global best is
+   * passed from outside).
    * Mutate w and chromosome and ensure constraints.
    *
    * \param index       : chromosome to be mutated
    * \param global_best : index of the global best chromosome
+   * \param v           : Output, the mutant
    */
 
-  std::vector<T> mutate(const std::size_t index, const std::size_t global_best);
+  void mutate(const std::size_t index,
+              const std::size_t global_best,
+              RowView<T> v);
 };  // class DEGL
 }  // namespace Algorithm
 }  // namespace DE
@@ -12,57 +12,99 @@
 #ifndef DE_ENGINE_HPP
 #define DE_ENGINE_HPP
 
+#include <cmath>
+#include <cstdint>
 #include <vector>
+#include <assert.h>
+#include "dimension.hpp"
+#include "matrix.hpp"
 #include "rand.hpp"
 
 namespace DE {
 namespace Algorithm {
 
+/*!
+ * \brief Perform binary crossover with a given mask
+ *
+ * \p trial may be the same buffer as \p donor, in which case the crossover
+ * happens in place.
+ *
+ * \param target : The target (inital) chromosome
+ * \param donor  : The donor (mutated) chromosome
+ * \param mask   : Genes with a non-zero flag come from the donor
+ * \param trial  : Output, the trial vector
+ */
+
+template <typename T>
+void binary_crossover(ConstRowView<T> target,
+                      ConstRowView<T> donor,
+                      ConstRowView<std::uint8_t> mask,
+                      RowView<T> trial) {
+  assert(target.size() == donor.size() && target.size() == trial.size());
+  assert(mask.size() == target.size());
+  with_dimension(target.size(), [&](const auto D) {
+    const T *t = target.data(), *d = donor.data();
+    const std::uint8_t* m = mask.data();
+    T* out = trial.data();
+    for (std::size_t j = 0; j < D; ++j)
+      out[j] = m[j] ? d[j] : t[j];
+  });
+}
+
 /*!
  * \brief Perform binary crossover
  *
+ * The mask is drawn in bulk (\see fill_crossover_mask); one random gene
+ * always comes from the donor. \p trial may be the same buffer as \p donor,
+ * in which case the crossover happens in place.
+ *
  * \param target : The target (inital) chromosome
  * \param donor  : The donor (mutated) chromosome
  * \param Cr     : The crossover factor
- *
- * \return The trial vector
+ * \param trial  : Output, the trial vector
  */
 
 template <typename T>
-std::vector<T> binary_crossover(const std::vector<T>& target,
-                                const std::vector<T>& donor,
-                                const float& Cr) {
-  auto trial = target;
+void binary_crossover(ConstRowView<T> target,
+                      ConstRowView<T> donor,
+                      const float& Cr,
+                      RowView<T> trial) {
   const std::size_t D = target.size(), j_rand = rand_uniform_int(0, D - 1);
-  for (std::size_t j = 0; j < D; ++j)
-    if (j == j_rand || rand_uniform_real(0, 1) <= Cr)
-      trial[j] = donor[j];
-  return trial;
+  ScratchVector<std::uint8_t> mask(D);
+  fill_crossover_mask(mask.data(), D, Cr);
+  mask[j_rand] = 1;
+  binary_crossover<T>(target, donor, mask.view(), trial);
 }
 
 /*!
  * \brief Perform exponential crossover
  *
+ * \p trial may be the same buffer as \p donor, in which case the crossover
+ * happens in place.
+ *
  * \param target : The target (inital) chromosome
  * \param donor  : The donor (mutated) chromosome
  * \param Cr     : The crossover factor
- *
- * \return The trial vector
+ * \param trial  : Output, the trial vector
  */
 
 template <typename T>
-std::vector<T> exponential_crossover(const std::vector<T>& target,
-                                     const std::vector<T>& donor,
-                                     const float& Cr) {
-  auto trial = target;
+void exponential_crossover(ConstRowView<T> target,
+                           ConstRowView<T> donor,
+                           const float& Cr,
+                           RowView<T> trial) {
+  assert(target.size() == donor.size() && target.size() == trial.size());
   const std::size_t D = target.size(), start = rand_uniform_int(0, D - 1);
-  std::size_t L = 0;  // Length of the two point crossover
-  do {
-    ++L;
-  } while (rand_uniform_real(0, 1) < Cr && L < D);
-  for (std::size_t j = start; j < start + L; ++j)
-    trial[start % D] = donor[start % D];
-  return trial;
+  // Length of the two point crossover; P(L > l) = Cr^l, drawn by inversion
+  std::size_t L = D;
+  if (Cr < 1) {
+    const double u = 1.0 - rand_uniform_real(0, 1);  // (0, 1]
+    const double l = Cr > 0 ? 1 + std::floor(std::log(u) / std::log(Cr)) : 1;
+    L = l < D ? std::size_t(l) : D;
+  }
+  // Genes [start, start + L) (cyclically) come from the donor
+  for (std::size_t j = 0; j < D; ++j)
+    trial[j] = ((j + D - start) % D < L) ? donor[j] : target[j];
 }
 }  // namespace Algorithm
 }  // namespace DE
@@ -19,8 +19,10 @@
 /*! Special value set in the crossover memory values */
 #define TERMINAL_VALUE -100
 
+#include <array>
+#include <cstdint>
 #include <vector>
-#include <mutex>
+#include "matrix.hpp"
 #include "algorithm/base_algorithm.hpp"
 
 namespace DE {
@@ -47,12 +49,17 @@ class SHADE : public Base<T> {
    * \param initial_chromosome        : An initial (ideally not random) solution
    * \param use_linear_size_reduction : If true, use L-SHADE
    * \param minimize                  : If true, minimize the fitness function
+   * \param executor                  : If given, run parallel computations
+   *                                    on it (\see Executor)
+   * \param run                       : Index of the run (\see Base)
    */
 
   SHADE(std::shared_ptr<Problem::Base<T>> problem,
         const std::vector<T>& initial_chromosome,
         const bool use_linear_size_reduction = false,
-        const bool minimize = true);
+        const bool minimize = true,
+        std::shared_ptr<Executor> executor = nullptr,
+        const std::size_t run = next_run());
 
   /*!
    * \brief Create a new optimizer from an existing initial chromosome and its
@@ -63,13 +70,18 @@ class SHADE : public Base<T> {
    * \param initial_fitness           : Fitness of initial_chromosome
    * \param use_linear_size_reduction : If true, use L-SHADE
    * \param minimize                  : If true, minimize the fitness function
+   * \param executor                  : If given, run parallel computations
+   *                                    on it (\see Executor)
+   * \param run                       : Index of the run (\see Base)
    */
 
   SHADE(std::shared_ptr<Problem::Base<T>> problem,
         const std::vector<T>& initial_chromosome,
         const double initial_fitness,
         const bool use_linear_size_reduction = false,
-        const bool minimize = true);
+        const bool minimize = true,
+        std::shared_ptr<Executor> executor = nullptr,
+        const std::size_t run = next_run());
 
   /*!
    * \brief Create a new optimizer with no a priori knowledge
@@ -77,11 +89,16 @@ class SHADE : public Base<T> {
    * \param problem                   : Pointer to a Base Problem
    * \param use_linear_size_reduction : If true, use L-SHADE
    * \param minimize                  : If true, minimize the fitness function
+   * \param executor                  : If given, run parallel computations
+   *                                    on it (\see Executor)
+   * \param run                       : Index of the run (\see Base)
    */
 
   SHADE(std::shared_ptr<Problem::Base<T>> problem,
         const bool use_linear_size_reduction = false,
-        const bool minimize = true);
+        const bool minimize = true,
+        std::shared_ptr<Executor> executor = nullptr,
+        const std::size_t run = next_run());
 
   /*!
    * \brief Apply the SHADE algorithm
@@ -98,12 +115,44 @@ class SHADE : public Base<T> {
   std::size_t p_;                        /*!< p in current-to-pbest */
   const std::size_t H_;                  /*!< Size of memory */
   std::size_t A_size_;                   /*!< Maximum size of archive */
-  std::vector<std::vector<T>> A_;        /*!< Chromosome archive */
+  Matrix<T> A_;                          /*!< Chromosome archive */
+  std::size_t A_count_;                  /*!< Chromosomes in the archive */
   std::vector<std::size_t> top_p_;       /*!< Indices of the top p solutions */
   std::vector<float> Cr_;                /*!< Crossover memory values (H_) */
   std::vector<float> F_;                 /*!< Scale factor memory values (H_) */
   const bool use_linear_size_reduction_; /*!< If true, use L-SHADE */
-  std::mutex pop_mutex_;                 /*!< Mutex for parallel processing */
+  std::vector<float> S_Cr_;              /*!< Successful Cr of a generation */
+  std::vector<float> S_F_;               /*!< Successful F of a generation */
+  std::vector<double> delta_fit_;        /*!< Improvement of each success */
+  std::vector<double> weights_;          /*!< Weights of the Lehmer mean */
+  std::vector<std::size_t> indices_;     /*!< Scratch space for sorting */
+  std::vector<double> scratch_fit_;      /*!< Scratch space for fitnesses */
+  std::vector<float> trial_Cr_;          /*!< Cr used for each trial (N_) */
+  std::vector<float> trial_F_;           /*!< F used for each trial (N_) */
+  /*! Indices of the p-best, r_1 and r_2 donors of each trial (N_) */
+  std::vector<std::array<std::size_t, 3>> donors_;
+  std::vector<std::uint32_t> random_bits_; /*!< Random bits (4 N_) */
+  std::vector<double> normal_draws_;     /*!< Normal variates (N_) */
+  std::vector<double> uniform_draws_;    /*!< Uniform variates (N_) */
+
+  /*!
+   * \brief Size all buffers used during the evolution
+   *
+   * Every buffer is allocated up front, so that a generation performs no
+   * heap allocations.
+   */
+
+  void initialize_buffers();
+
+  /*!
+   * \brief Draw the parameters of every trial of the generation
+   *
+   * The memory indices, Cr, F and the indices of the donors of all trials
+   * are drawn in bulk from one stream of the generation and stored in
+   * trial_Cr_, trial_F_ and donors_.
+   */
+
+  void draw_parameters();
 
   /*!
    * \brief Generate the crossover factor
@@ -111,11 +160,13 @@ class SHADE : public Base<T> {
    * Refer to Equation (1) in \cite Tanabe2014
    *
    * \param rand_index : Index between [0, H_) pointing to Cr_
+   * \param z          : A standard normal variate
    *
    * \return The Cr to be used
    */
 
-  float get_crossover_factor(const std::size_t rand_index) const;
+  float get_crossover_factor(const std::size_t rand_index,
+                             const double z) const;
 
   /*!
    * \brief Generate the scale factor
@@ -123,27 +174,23 @@ class SHADE : public Base<T> {
    * Refer to Equation (2) in \cite Tanabe2014
    *
    * \param rand_index : Index between [0, H_) pointing to F_
+   * \param u          : A uniform variate within [0, 1)
    *
    * \return The F to be used
    */
 
-  float get_scale_factor(const std::size_t rand_index) const;
+  float get_scale_factor(const std::size_t rand_index, const double u) const;
 
   /*!
    * \brief Update the memory values for Cr and F
    *
-   * Refer to Algorithm 1 in \cite Tanabe2014
+   * Refer to Algorithm 1 in \cite Tanabe2014. The successful values of the
+   * generation are read from S_Cr_, S_F_ and delta_fit_.
    *
-   * \param S_Cr      : Set of successful Crossover values
-   * \param S_F       : Set of successful Scale factor values
-   * \param delta_fit : delta f for each successful value
-   * \param k         : Index to the memory place to be updated
+   * \param k : Index to the memory place to be updated
    */
 
-  void memory_update(const std::vector<float>& S_Cr,
-                     const std::vector<float>& S_F,
-                     const std::vector<double>& delta_fit,
-                     const std::size_t k);
+  void memory_update(const std::size_t k);
 
   /*!
    * \brief Calculate the weighted Lehmer mean
@@ -164,7 +211,7 @@ class SHADE : public Base<T> {
    * \param chromosome : The chromosome to be appended to A_
    */
 
-  void add_to_archive(const std::vector<T>& chromosome);
+  void add_to_archive(ConstRowView<T> chromosome);
 
   /*!
    * \brief Find the top p solutions in x_ and update top_p_
@@ -175,13 +222,16 @@ class SHADE : public Base<T> {
   /*!
    * \brief Mutate a chromosome using current-to-pbest/1
    *
+   * The donors are read from donors_.
+   *
    * \param base_index : The current index
    * \param F          : The scale factor
-   *
-   * \return The mutant
+   * \param mutant     : Output, the mutant
    */
 
-  std::vector<T> mutate(const std::size_t base_index, const float F) const;
+  void mutate(const std::size_t base_index,
+              const float F,
+              RowView<T> mutant) const;
 
   /*!
    * \brief Apply linear size reduction
@@ -195,10 +245,39 @@ class SHADE : public Base<T> {
   void linear_size_reduction(const std::size_t current_generation,
                              const std::size_t max_generations);
 
-  void parallel_evolve(const std::size_t thread_id,
-                       std::vector<float>& S_Cr,
-                       std::vector<float>& S_F,
-                       std::vector<double>& delta_fit);
+  /*!
+   * \brief Generate and evaluate the trials of a chunk of chromosomes
+   *
+   * Only trials_, trial_fit_, trial_Cr_ and trial_F_ of the chunk are
+   * written; the population, the archive and the memories are only read.
+   * Hence chunks may run concurrently on the executor without any lock.
+   *
+   * \param begin : Index of the first chromosome
+   * \param end   : One past the index of the last chromosome
+   */
+
+  void generate_trials(const std::size_t begin, const std::size_t end);
+
+  /*!
+   * \brief Select between a chromosome and its trial vector
+   *
+   * If the trial is strictly better, the parent is archived and the
+   * parameters are stored as successful. Selections are applied in index
+   * order once all trials of a generation have been evaluated, so the
+   * outcome does not depend on how the trials were scheduled.
+   *
+   * \param i : Index of the chromosome
+   */
+
+  void select(const std::size_t i);
+
+  /*!
+   * \brief Hand the state after the generation to the observer
+   *
+   * The successes are those of S_F_, the memories those after the update.
+   */
+
+  void report_generation() const;
 
 };  // class SHADE
 }  // namespace Algorithm
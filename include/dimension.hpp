@@ -0,0 +1,89 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief Compile-time number of genes for the common dimensions
+ *
+ * The CEC benchmarks run on 10, 30, 50 and 100 genes. Code that loops over
+ * the genes can be written once as a generic lambda (or template) over the
+ * type of the dimension, and with_dimension instantiates it for each of
+ * these with the number of genes as a compile-time constant, so that the
+ * compiler fully unrolls and vectorizes the loops and keeps short
+ * chromosomes in registers. Any other dimension runs the same code with a
+ * std::size_t.
+ */
+
+#ifndef DE_DIMENSION_HPP
+#define DE_DIMENSION_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include "matrix.hpp"
+
+namespace DE {
+
+/*! A number of genes known at compile time; converts to std::size_t */
+template <std::size_t D>
+using Dimension = std::integral_constant<std::size_t, D>;
+
+/*!
+ * \brief Call \p f with the number of genes, at compile time if possible
+ *
+ * \param D : The number of genes
+ * \param f : Callable with a Dimension<D> and with a std::size_t
+ *
+ * \return What \p f returns
+ */
+
+template <class F>
+decltype(auto) with_dimension(const std::size_t D, F&& f) {
+  switch (D) {
+    case 10:
+      return f(Dimension<10>());
+    case 30:
+      return f(Dimension<30>());
+    case 50:
+      return f(Dimension<50>());
+    case 100:
+      return f(Dimension<100>());
+    default:
+      return f(D);
+  }
+}
+
+/*!
+ * \class GeneBuffer
+ * \brief A chromosome of intermediate results
+ *
+ * Room for Matrix<T>::padded_size(D) genes, so that vector kernels may
+ * write whole vectors: on the stack (a std::array) for a compile-time
+ * dimension, a ScratchVector otherwise.
+ *
+ * \tparam T   : Type of the genes
+ * \tparam Dim : Dimension<D> or std::size_t
+ */
+
+template <typename T, class Dim>
+class GeneBuffer : public ScratchVector<T> {
+ public:
+  explicit GeneBuffer(const std::size_t D)
+      : ScratchVector<T>(Matrix<T>::padded_size(D)) {}
+};
+
+template <typename T, std::size_t D>
+class GeneBuffer<T, Dimension<D>> {
+ public:
+  explicit GeneBuffer(Dimension<D>) {}
+
+  T& operator[](const std::size_t i) { return genes_[i]; }
+  T* data() { return genes_.data(); }
+  std::size_t size() const { return genes_.size(); }
+
+ private:
+  alignas(64) std::array<T, Matrix<T>::padded_size(D)> genes_;
+};
+
+}  // namespace DE
+#endif  // DE_DIMENSION_HPP
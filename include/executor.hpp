@@ -0,0 +1,318 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief Executors which run the parallel parts of the algorithms
+ *
+ * An algorithm receives an executor at construction and hands it loops over
+ * the individuals of a generation. The executor splits each loop into chunks
+ * of consecutive indices and decides on which threads they run: inline on the
+ * calling thread (SerialExecutor), on a persistent pool of workers
+ * (ThreadPoolExecutor), or anywhere else a user-supplied Executor wants.
+ */
+
+#ifndef DE_EXECUTOR_HPP
+#define DE_EXECUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace DE {
+
+/*!
+ * \class TaskRef
+ * \brief A non-owning reference to a callable `void(begin, end)`
+ *
+ * Unlike std::function it never allocates; the referenced callable must
+ * outlive the TaskRef, which always holds for a blocking parallel_for.
+ */
+
+class TaskRef {
+ public:
+  template <class F,
+            typename = std::enable_if_t<
+                !std::is_same<std::decay_t<F>, TaskRef>::value>>
+  TaskRef(F&& f)
+      : object_(const_cast<void*>(static_cast<const void*>(&f))),
+        call_(&invoke<std::remove_reference_t<F>>) {}
+
+  /*!
+   * \brief Run the task on the indices [begin, end)
+   */
+
+  void operator()(const std::size_t begin, const std::size_t end) const {
+    call_(object_, begin, end);
+  }
+
+ private:
+  void* object_; /*!< The referenced callable */
+  void (*call_)(void*, std::size_t, std::size_t); /*!< Type-erased call */
+
+  template <class F>
+  static void invoke(void* f, const std::size_t begin, const std::size_t end) {
+    (*static_cast<F*>(f))(begin, end);
+  }
+};
+
+/*!
+ * \class Executor
+ * \brief Interface of all executors
+ *
+ * Inherit this class to run the loops of the algorithms on your own
+ * threads; only parallel_for and num_threads need to be implemented.
+ */
+
+class Executor {
+ public:
+  /*!
+   * \brief Create an executor
+   *
+   * \param chunk_size : Consecutive indices handed to a thread at once; if 0
+   *                     the executor picks one per loop
+   */
+
+  explicit Executor(const std::size_t chunk_size = 0)
+      : chunk_size_(chunk_size) {}
+
+  virtual ~Executor() = default;
+
+  /*!
+   * \brief Run \p task over the indices [0, n) and wait for it to finish
+   *
+   * The range is split into disjoint chunks [begin, end) which may run
+   * concurrently and in any order. If a chunk throws, the exception is
+   * rethrown on the calling thread once all chunks have finished.
+   *
+   * It may be called from within a chunk of another loop of the same
+   * executor (for instance by a fitness_batch evaluated in parallel), and
+   * from several threads at once, e.g. by optimizers sharing the executor.
+   * Executors must either run such loops concurrently or serialize them.
+   *
+   * \param n    : Number of indices
+   * \param task : Called once per chunk
+   */
+
+  virtual void parallel_for(const std::size_t n, TaskRef task) = 0;
+
+  /*!
+   * \brief Number of threads which may execute chunks concurrently
+   */
+
+  virtual std::size_t num_threads() const = 0;
+
+  /*!
+   * \brief Set the number of consecutive indices handed to a thread at once
+   *
+   * \param chunk_size : The new chunk size; if 0 it is picked automatically
+   */
+
+  void set_chunk_size(const std::size_t chunk_size) {
+    chunk_size_ = chunk_size;
+  }
+
+  /*!
+   * \brief The chunk size used for a loop over \p n indices
+   *
+   * \param n : Number of indices of the loop
+   *
+   * \return The configured chunk size, or if it is 0, roughly four chunks
+   *         per thread
+   */
+
+  std::size_t chunk_size(const std::size_t n) const {
+    if (chunk_size_ > 0)
+      return chunk_size_;
+    const std::size_t chunks = 4 * num_threads();
+    return std::max<std::size_t>(1, (n + chunks - 1) / chunks);
+  }
+
+ private:
+  std::size_t chunk_size_; /*!< Configured chunk size (0: automatic) */
+};
+
+/*!
+ * \class SerialExecutor
+ * \brief Runs every loop inline on the calling thread
+ */
+
+class SerialExecutor : public Executor {
+ public:
+  using Executor::Executor;
+
+  void parallel_for(const std::size_t n, TaskRef task) {
+    if (n > 0)
+      task(0, n);
+  }
+
+  std::size_t num_threads() const { return 1; }
+};
+
+/*!
+ * \class ThreadPoolExecutor
+ * \brief Runs loops on a persistent pool of worker threads
+ *
+ * The workers are created once. Between loops they spin for a short while,
+ * so that back-to-back generations do not pay for a wake-up, and then park
+ * on a condition variable. The calling thread takes part in every loop.
+ *
+ * The pool runs one loop at a time. A loop started from within a chunk of
+ * the pool runs inline on that thread, as a whole. Loops started by other
+ * threads, such as optimizers sharing the pool, wait for their turn. Pools
+ * must not call each other in a cycle (a chunk of pool A starting a loop of
+ * pool B whose chunks start a loop of A), since the inner loop of A would
+ * wait for the outer one.
+ */
+
+class ThreadPoolExecutor : public Executor {
+ public:
+  /*!
+   * \brief Start the workers
+   *
+   * \param num_threads : Total number of threads, including the caller of
+   *                      parallel_for; 0 means one per hardware thread
+   * \param chunk_size  : \see Executor::Executor
+   */
+
+  explicit ThreadPoolExecutor(const std::size_t num_threads = 0,
+                              const std::size_t chunk_size = 0)
+      : Executor(chunk_size) {
+    std::size_t threads =
+        num_threads > 0 ? num_threads : std::thread::hardware_concurrency();
+    threads = std::max<std::size_t>(1, threads);
+    workers_.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i)
+      workers_.emplace_back(&ThreadPoolExecutor::worker_loop, this);
+  }
+
+  /*! Stop and join the workers */
+  ~ThreadPoolExecutor() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_)
+      worker.join();
+  }
+
+  ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+  ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+  void parallel_for(const std::size_t n, TaskRef task) {
+    if (n == 0)
+      return;
+    const std::size_t chunk = chunk_size(n);
+    if (workers_.empty() || n <= chunk || running_pool() == this) {
+      task(0, n);
+      return;
+    }
+    std::lock_guard<std::mutex> turn(caller_mutex_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &task;
+      n_ = n;
+      chunk_ = chunk;
+      next_ = 0;
+      busy_ = workers_.size();
+      error_ = nullptr;
+      job_.fetch_add(1, std::memory_order_release);
+    }
+    wake_.notify_all();
+    run_chunks();
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return busy_ == 0; });
+    task_ = nullptr;
+    if (error_)
+      std::rethrow_exception(error_);
+  }
+
+  std::size_t num_threads() const { return workers_.size() + 1; }
+
+ private:
+  /*! Iterations a worker spins waiting for the next loop before parking */
+  static constexpr std::size_t spin_count_ = 4096;
+
+  std::vector<std::thread> workers_;  /*!< The worker threads */
+  std::mutex caller_mutex_;           /*!< Held by the caller of a loop */
+  std::mutex mutex_;                  /*!< Guards the state below */
+  std::condition_variable wake_;      /*!< Wakes parked workers */
+  std::condition_variable done_;      /*!< Signals the end of a loop */
+  std::atomic<std::size_t> job_{0};   /*!< Incremented for every loop */
+  bool stop_ = false;                 /*!< True when the pool shuts down */
+  const TaskRef* task_ = nullptr;     /*!< Task of the current loop */
+  std::size_t n_ = 0;                 /*!< Indices of the current loop */
+  std::size_t chunk_ = 1;             /*!< Chunk size of the current loop */
+  std::atomic<std::size_t> next_{0};  /*!< First index not yet claimed */
+  std::size_t busy_ = 0;              /*!< Workers still in the loop */
+  std::exception_ptr error_;          /*!< First exception of the loop */
+
+  /*! The pool whose chunk the calling thread runs, if any */
+  static const ThreadPoolExecutor*& running_pool() {
+    thread_local const ThreadPoolExecutor* pool = nullptr;
+    return pool;
+  }
+
+  /*! Claim and run chunks of the current loop until none is left */
+  void run_chunks() {
+    const ThreadPoolExecutor* const previous = running_pool();
+    running_pool() = this;
+    for (;;) {
+      const std::size_t begin = next_.fetch_add(chunk_);
+      if (begin >= n_)
+        break;
+      try {
+        (*task_)(begin, std::min(begin + chunk_, n_));
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_)
+          error_ = std::current_exception();
+      }
+    }
+    running_pool() = previous;
+  }
+
+  /*! Body of every worker: wait for a loop, help with it, repeat */
+  void worker_loop() {
+    std::size_t seen = 0;
+    for (;;) {
+      for (std::size_t i = 0; i < spin_count_ &&
+                              job_.load(std::memory_order_acquire) == seen;
+           ++i)
+        std::this_thread::yield();
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this, seen] { return stop_ || job_ != seen; });
+        if (stop_)
+          return;
+        seen = job_;
+      }
+      run_chunks();
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--busy_ == 0)
+        done_.notify_one();
+    }
+  }
+};
+
+/*!
+ * \brief Create the default executor for parallel computations
+ *
+ * \return A ThreadPoolExecutor with one thread per hardware thread
+ */
+
+inline std::shared_ptr<Executor> make_default_executor() {
+  return std::make_shared<ThreadPoolExecutor>();
+}
+
+}  // namespace DE
+
+#endif  // DE_EXECUTOR_HPP
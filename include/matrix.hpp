@@ -0,0 +1,407 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief Contiguous, aligned row-major storage for populations of chromosomes
+ *
+ * A population of N chromosomes with D genes each is stored in a single
+ * allocation. Every row starts on a cache line and its stride is rounded up
+ * to the width of the widest SIMD register, so that kernels can stream
+ * through rows without peeling. Rows are accessed through lightweight views
+ * which can be handed to problems and archives without copying.
+ */
+
+#ifndef DE_MATRIX_HPP
+#define DE_MATRIX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <deque>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <assert.h>
+
+namespace DE {
+
+/*! Size of a cache line in bytes */
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/*! Size in bytes of the widest supported SIMD register (AVX-512) */
+constexpr std::size_t SIMD_REGISTER_SIZE = 64;
+
+/*!
+ * \class AlignedAllocator
+ * \brief A minimal allocator returning memory aligned to \p Alignment bytes
+ */
+
+template <typename T, std::size_t Alignment = CACHE_LINE_SIZE>
+class AlignedAllocator {
+  static_assert((Alignment & (Alignment - 1)) == 0,
+                "Alignment must be a power of two");
+
+ public:
+  using value_type = T; /*!< Allocated type */
+
+  /*! Rebind the allocator to a different type (required by containers) */
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>; /*!< Rebound allocator */
+  };
+
+  AlignedAllocator() = default;
+
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+  /*!
+   * \brief Allocate aligned memory for \p n objects
+   *
+   * Memory is obtained from the global operator new, so that replacements of
+   * it (e.g. allocation counters) observe every allocation. The address
+   * returned by operator new is stored right before the aligned block.
+   *
+   * \throw std::bad_alloc if the allocation fails
+   */
+
+  T* allocate(const std::size_t n) {
+    void* raw = ::operator new(n * sizeof(T) + Alignment + sizeof(void*));
+    const auto address = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+    void* aligned = reinterpret_cast<void*>((address + Alignment - 1) &
+                                            ~(std::uintptr_t(Alignment) - 1));
+    static_cast<void**>(aligned)[-1] = raw;
+    return static_cast<T*>(aligned);
+  }
+
+  /*! Release memory obtained by allocate */
+  void deallocate(T* p, std::size_t) {
+    ::operator delete(reinterpret_cast<void**>(p)[-1]);
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment>&) const {
+    return false;
+  }
+};
+
+/*!
+ * \class RowView
+ * \brief A non-owning view over \p size contiguous genes
+ *
+ * Similar to std::span (C++20). RowView<const T> (\see ConstRowView) binds
+ * implicitly to a std::vector or a braced list, so the existing interfaces
+ * taking chromosomes keep working with both vectors and population rows.
+ */
+
+template <typename T>
+class RowView {
+ public:
+  using value_type = std::remove_const_t<T>; /*!< Type of each gene */
+
+  /*!
+   * \brief View over \p size elements starting at \p data
+   */
+
+  RowView(T* data, const std::size_t size) : data_(data), size_(size){};
+
+  /*! View over the whole of a vector */
+  RowView(std::vector<value_type>& v) : data_(v.data()), size_(v.size()){};
+
+  /*! Read-only view over the whole of a const vector */
+  template <typename U = T,
+            typename = std::enable_if_t<std::is_const<U>::value>>
+  RowView(const std::vector<value_type>& v)
+      : data_(v.data()), size_(v.size()) {}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winit-list-lifetime"
+#endif
+  /*! Read-only view over a braced list, valid for the full expression */
+  template <typename U = T,
+            typename = std::enable_if_t<std::is_const<U>::value>>
+  RowView(std::initializer_list<value_type> l)
+      : data_(l.begin()), size_(l.size()) {}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9
+#pragma GCC diagnostic pop
+#endif
+
+  /*! Read-only view from a mutable one */
+  template <typename U,
+            typename = std::enable_if_t<std::is_same<const U, T>::value>>
+  RowView(const RowView<U>& other)
+      : data_(other.data()), size_(other.size()) {}
+
+  T& operator[](const std::size_t i) const {
+    assert(i < size_);
+    return data_[i];
+  }
+
+  T* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  T* begin() const { return data_; }
+  T* end() const { return data_ + size_; }
+
+ private:
+  T* data_;          /*!< First gene */
+  std::size_t size_; /*!< Number of genes */
+};
+
+/*! A read-only chromosome */
+template <typename T>
+using ConstRowView = RowView<const T>;
+
+/*!
+ * \class Matrix
+ * \brief Row-major matrix with aligned and padded rows
+ *
+ * The stride of every row is a multiple of SIMD_REGISTER_SIZE bytes, hence
+ * each row is aligned to a cache line. Padding elements are zero.
+ */
+
+template <typename T>
+class Matrix {
+ public:
+  /*! Create an empty matrix */
+  Matrix() : rows_(0), cols_(0), stride_(0){};
+
+  /*!
+   * \brief Create a \p rows x \p cols matrix
+   *
+   * \param rows  : Number of rows (e.g. chromosomes)
+   * \param cols  : Number of columns (e.g. genes)
+   * \param value : Initial value of every element
+   */
+
+  Matrix(const std::size_t rows, const std::size_t cols, const T value = T())
+      : rows_(rows),
+        cols_(cols),
+        stride_(padded_size(cols)),
+        data_(rows_ * stride_, T()) {
+    for (std::size_t i = 0; i < rows_; ++i)
+      std::fill_n(row_data(i), cols_, value);
+  };
+
+  /*!
+   * \brief Number of elements per row after padding
+   *
+   * \param cols : Number of useful elements per row
+   *
+   * \return \p cols rounded up to a multiple of SIMD_REGISTER_SIZE bytes
+   */
+
+  static constexpr std::size_t padded_size(const std::size_t cols) {
+    return (cols + lanes - 1) / lanes * lanes;
+  }
+
+  std::size_t rows() const { return rows_; }
+  std::size_t cols() const { return cols_; }
+  bool empty() const { return rows_ == 0; }
+
+  /*! Distance in elements between the starts of two consecutive rows */
+  std::size_t stride() const { return stride_; }
+
+  T* data() { return data_.data(); }
+  const T* data() const { return data_.data(); }
+
+  RowView<T> operator[](const std::size_t i) {
+    assert(i < rows_);
+    return RowView<T>(row_data(i), cols_);
+  }
+
+  ConstRowView<T> operator[](const std::size_t i) const {
+    assert(i < rows_);
+    return ConstRowView<T>(row_data(i), cols_);
+  }
+
+  /*!
+   * \brief Change the number of rows, keeping the leading ones intact
+   *
+   * Shrinking never reallocates.
+   *
+   * \param rows : The new number of rows
+   */
+
+  void resize(const std::size_t rows) {
+    data_.resize(rows * stride_, T());
+    rows_ = rows;
+  }
+
+  /*!
+   * \brief Swap the contents of two rows
+   */
+
+  void swap_rows(const std::size_t i, const std::size_t j) {
+    assert(i < rows_ && j < rows_);
+    std::swap_ranges(row_data(i), row_data(i) + cols_, row_data(j));
+  }
+
+ private:
+  /*! Number of elements of type T in a SIMD register */
+  static constexpr std::size_t lanes =
+      SIMD_REGISTER_SIZE / sizeof(T) > 0 ? SIMD_REGISTER_SIZE / sizeof(T) : 1;
+
+  std::size_t rows_;   /*!< Number of rows */
+  std::size_t cols_;   /*!< Number of useful columns */
+  std::size_t stride_; /*!< Padded number of columns */
+  /*! Contiguous storage of rows_ * stride_ elements */
+  std::vector<T, AlignedAllocator<T>> data_;
+
+  T* row_data(const std::size_t i) { return data_.data() + i * stride_; }
+  const T* row_data(const std::size_t i) const {
+    return data_.data() + i * stride_;
+  }
+};
+
+template <typename T>
+constexpr std::size_t Matrix<T>::lanes;
+
+/*!
+ * \class BlockView
+ * \brief A non-owning view over consecutive rows of a matrix
+ *
+ * Used to hand a whole generation of chromosomes to a problem at once.
+ * BlockView<const T> (\see ConstBlockView) binds implicitly to a Matrix.
+ */
+
+template <typename T>
+class BlockView {
+ public:
+  using value_type = std::remove_const_t<T>; /*!< Type of each gene */
+
+  /*!
+   * \brief View over \p rows rows of \p cols elements
+   *
+   * \param data   : First element of the first row
+   * \param rows   : Number of rows
+   * \param cols   : Number of useful elements per row
+   * \param stride : Distance in elements between two consecutive rows
+   */
+
+  BlockView(T* data,
+            const std::size_t rows,
+            const std::size_t cols,
+            const std::size_t stride)
+      : data_(data), rows_(rows), cols_(cols), stride_(stride) {
+    assert(stride_ >= cols_);
+  }
+
+  /*! View over all the rows of a matrix */
+  BlockView(Matrix<value_type>& m)
+      : BlockView(m.data(), m.rows(), m.cols(), m.stride()) {}
+
+  /*! Read-only view over all the rows of a const matrix */
+  template <typename U = T,
+            typename = std::enable_if_t<std::is_const<U>::value>>
+  BlockView(const Matrix<value_type>& m)
+      : BlockView(m.data(), m.rows(), m.cols(), m.stride()) {}
+
+  /*! Read-only view from a mutable one */
+  template <typename U,
+            typename = std::enable_if_t<std::is_same<const U, T>::value>>
+  BlockView(const BlockView<U>& other)
+      : BlockView(other.data(), other.rows(), other.cols(), other.stride()) {}
+
+  RowView<T> operator[](const std::size_t i) const {
+    assert(i < rows_);
+    return RowView<T>(data_ + i * stride_, cols_);
+  }
+
+  /*!
+   * \brief View over a subset of the rows
+   *
+   * \param first : Index of the first row
+   * \param count : Number of rows
+   */
+
+  BlockView slice(const std::size_t first, const std::size_t count) const {
+    assert(first + count <= rows_);
+    return BlockView(data_ + first * stride_, count, cols_, stride_);
+  }
+
+  T* data() const { return data_; }
+  std::size_t rows() const { return rows_; }
+  std::size_t cols() const { return cols_; }
+  std::size_t stride() const { return stride_; }
+  bool empty() const { return rows_ == 0; }
+
+ private:
+  T* data_;            /*!< First element of the first row */
+  std::size_t rows_;   /*!< Number of rows */
+  std::size_t cols_;   /*!< Number of useful columns */
+  std::size_t stride_; /*!< Distance between consecutive rows */
+};
+
+/*! A read-only block of chromosomes */
+template <typename T>
+using ConstBlockView = BlockView<const T>;
+
+/*!
+ * \class ScratchVector
+ * \brief A per-thread, reusable buffer for intermediate chromosomes
+ *
+ * Problems transform chromosomes before evaluating them, but must remain
+ * callable from many threads at once. Each thread keeps one buffer per
+ * nesting level (composition and hybrid functions evaluate their components
+ * from within their own fitness), so after the first evaluation on a thread
+ * no further heap allocations take place.
+ */
+
+template <typename T>
+class ScratchVector {
+ public:
+  /*!
+   * \brief Acquire the next free buffer of this thread
+   *
+   * \param size : Number of elements needed
+   */
+
+  explicit ScratchVector(const std::size_t size) : level_(depth()++) {
+    auto& pool = buffers();
+    if (pool.size() <= level_)
+      pool.emplace_back();
+    buffer_ = &pool[level_];
+    buffer_->resize(size);
+  }
+
+  ~ScratchVector() { --depth(); }
+
+  ScratchVector(const ScratchVector&) = delete;
+  ScratchVector& operator=(const ScratchVector&) = delete;
+
+  T& operator[](const std::size_t i) { return (*buffer_)[i]; }
+  T* data() { return buffer_->data(); }
+  std::size_t size() const { return buffer_->size(); }
+  RowView<T> view() { return RowView<T>(buffer_->data(), buffer_->size()); }
+
+ private:
+  using buffer_type = std::vector<T, AlignedAllocator<T>>;
+
+  const std::size_t level_; /*!< Nesting level of this buffer */
+  buffer_type* buffer_;     /*!< The acquired buffer */
+
+  /*! Buffers of this thread; a deque keeps them in place as it grows */
+  static std::deque<buffer_type>& buffers() {
+    thread_local std::deque<buffer_type> pool;
+    return pool;
+  }
+
+  /*! Number of buffers currently acquired by this thread */
+  static std::size_t& depth() {
+    thread_local std::size_t d = 0;
+    return d;
+  }
+};
+
+}  // namespace DE
+
+#endif  // DE_MATRIX_HPP
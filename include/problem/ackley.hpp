@@ -4,6 +4,7 @@
 #include <cmath>
 #include <assert.h>
 #include "problem/cec_basic_problem.hpp"
+#include "simd.hpp"
 
 namespace DE {
 namespace Problem {
@@ -19,20 +20,29 @@ namespace Problem {
  * \f$
  */
 
-class AckleyFunction : public CECFunction<double> {
+template <class T>
+class AckleyFunction : public CECFunction<T> {
  public:
   explicit AckleyFunction(const std::size_t D)
-      : CECFunction(D, "Ackley's Function") {}
+      : CECFunction<T>(D, "Ackley's Function") {}
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
     double sum_1 = 0.0, sum_2 = 0.0;
-    for (std::size_t i = 0; i < D_; ++i) {
-      sum_1 += chromosome[i] * chromosome[i];
-      sum_2 += cos(2 * M_PI * chromosome[i]);
+    if (SIMD::enabled()) {
+      double sums[2];
+      const detail::DoubleGenes<T> x(chromosome);
+      SIMD::kernels().ackley_sums(x.data(), this->D_, sums);
+      sum_1 = sums[0];
+      sum_2 = sums[1];
+    } else {
+      for (std::size_t i = 0; i < this->D_; ++i) {
+        sum_1 += chromosome[i] * chromosome[i];
+        sum_2 += cos(2 * M_PI * chromosome[i]);
+      }
     }
-    return -20.0 * std::exp(-0.2 * sqrt(sum_1 / D_)) - std::exp(sum_2 / D_) +
-           20 + std::exp(1.0);
+    return -20.0 * std::exp(-0.2 * sqrt(sum_1 / this->D_)) -
+           std::exp(sum_2 / this->D_) + 20 + std::exp(1.0);
   }
 };
 }  // namespace Problem
@@ -10,6 +10,7 @@
 #define DE_BASE_PROBLEM_HPP
 
 #include <vector>
+#include "matrix.hpp"
 
 namespace DE {
 
@@ -50,7 +51,7 @@ class Base {
    * \param chromosome : the chromosome to be randomized
    */
 
-  virtual void randomize(std::vector<T>& chromosome) const = 0;
+  virtual void randomize(RowView<T> chromosome) const = 0;
 
   /*!
    * \brief Constrain a given chromosome
@@ -60,7 +61,46 @@ class Base {
    * \param chromosome : the chromosome to be constrained
    */
 
-  virtual void constrain(std::vector<T>& chromosome) const = 0;
+  virtual void constrain(RowView<T> chromosome) const = 0;
+
+  /*!
+   * \brief Constrain a trial vector built from a parent
+   *
+   * Some repairs move a gene that left its bounds towards the gene of the
+   * parent (\see BoundHandling). The default ignores the parent.
+   *
+   * \param trial  : the chromosome to be constrained
+   * \param parent : the chromosome \p trial was built from
+   */
+
+  virtual void constrain_trial(RowView<T> trial, ConstRowView<T>) const {
+    constrain(trial);
+  }
+
+  /*!
+   * \brief Randomize a block of chromosomes, one after the other
+   *
+   * \param chromosomes : the chromosomes to be randomized, one per row
+   */
+
+  virtual void randomize_batch(BlockView<T> chromosomes) const {
+    for (std::size_t i = 0; i < chromosomes.rows(); ++i)
+      randomize(chromosomes[i]);
+  }
+
+  /*!
+   * \brief Constrain a block of trial vectors, one after the other
+   *
+   * \param trials  : the chromosomes to be constrained, one per row
+   * \param parents : the chromosome each trial was built from
+   */
+
+  virtual void constrain_batch(BlockView<T> trials,
+                               ConstBlockView<T> parents) const {
+    assert(parents.rows() == trials.rows());
+    for (std::size_t i = 0; i < trials.rows(); ++i)
+      constrain_trial(trials[i], parents[i]);
+  }
 
   /*!
    * \brief Calculate the fitness of the chromosome
@@ -68,7 +108,24 @@ class Base {
    * \param chromosome : the chromosome to be evaluated
    */
 
-  virtual double fitness(const std::vector<T>& chromosome) const = 0;
+  virtual double fitness(ConstRowView<T> chromosome) const = 0;
+
+  /*!
+   * \brief Calculate the fitness of a block of chromosomes
+   *
+   * Algorithms produce a whole generation of trials before they need any of
+   * the results; problems may override this to amortize their work across
+   * the block. The default evaluates each chromosome with fitness.
+   *
+   * \param chromosomes : The chromosomes to be evaluated, one per row
+   * \param fitness     : Output, one value per row of \p chromosomes
+   */
+
+  virtual void fitness_batch(ConstBlockView<T> chromosomes,
+                             double* fitness) const {
+    for (std::size_t i = 0; i < chromosomes.rows(); ++i)
+      fitness[i] = this->fitness(chromosomes[i]);
+  }
 
   /*!
    * \brief Get the number of genes
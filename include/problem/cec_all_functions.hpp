@@ -81,13 +81,20 @@ std::string shuffle_file(const std::size_t problem, const std::size_t D) {
 /*!
  * \brief Create a new function for CEC-2017
  *
+ * The data of the function are loaded by the first function created for a
+ * number and dimensions and shared by the following ones, in any thread
+ * (\see DE::Problem::CECDataRegistry).
+ *
  * \param function : Pointer to the function to be created
  * \param num      : Which function to create [1-15]
  * \param D        : Dimensions of the problem
+ *
+ * \tparam T : Type of the genes, double or float
  */
 
+template <class T>
 void initialize_function(
-    std::unique_ptr<DE::Problem::CECFunction<double>>& function,
+    std::unique_ptr<DE::Problem::CECFunction<T>>& function,
     const std::size_t num,
     const std::size_t D) {
   auto shift_str = shift_file(num), rotation_str = rotation_file(num, D),
@@ -96,115 +103,116 @@ void initialize_function(
        shuffle_f = shuffle_str.c_str();
   switch (num) {
     case 1:
-      function = std::make_unique<DE::Problem::CigarFunction>(D);
+      function = std::make_unique<DE::Problem::CigarFunction<T>>(D);
       break;
     case 2:
-      function = std::make_unique<DE::Problem::SumOfDifferentPowerFunction>(D);
+      function =
+          std::make_unique<DE::Problem::SumOfDifferentPowerFunction<T>>(D);
       break;
     case 3:
-      function = std::make_unique<DE::Problem::ZakharovFunction>(D);
+      function = std::make_unique<DE::Problem::ZakharovFunction<T>>(D);
       break;
     case 4:
-      function = std::make_unique<DE::Problem::RosenbrockFunction>(D);
+      function = std::make_unique<DE::Problem::RosenbrockFunction<T>>(D);
       break;
     case 5:
-      function = std::make_unique<DE::Problem::RastriginFunction>(D);
+      function = std::make_unique<DE::Problem::RastriginFunction<T>>(D);
       break;
     case 6:
-      function = std::make_unique<DE::Problem::SchafferFunction>(D);
+      function = std::make_unique<DE::Problem::SchafferFunction<T>>(D);
       break;
     case 7:
-      function = std::make_unique<DE::Problem::LunacekBiRastriginFunction>(D);
+      function =
+          std::make_unique<DE::Problem::LunacekBiRastriginFunction<T>>(D);
       break;
     case 8:
-      function =
-          std::make_unique<DE::Problem::RastriginNonContinuousRotatedFunction>(
-              D);
+      function = std::make_unique<
+          DE::Problem::RastriginNonContinuousRotatedFunction<T>>(D);
       break;
     case 9:
-      function = std::make_unique<DE::Problem::LevyFunction>(D);
+      function = std::make_unique<DE::Problem::LevyFunction<T>>(D);
       break;
     case 10:
-      function = std::make_unique<DE::Problem::SchwefelFunction>(D);
+      function = std::make_unique<DE::Problem::SchwefelFunction<T>>(D);
       break;
     case 11:
-      function = std::make_unique<DE::Problem::HybridFunction1>(
+      function = std::make_unique<DE::Problem::HybridFunction1<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 12:
-      function = std::make_unique<DE::Problem::HybridFunction2>(
+      function = std::make_unique<DE::Problem::HybridFunction2<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 13:
-      function = std::make_unique<DE::Problem::HybridFunction3>(
+      function = std::make_unique<DE::Problem::HybridFunction3<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 14:
-      function = std::make_unique<DE::Problem::HybridFunction4>(
+      function = std::make_unique<DE::Problem::HybridFunction4<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 15:
-      function = std::make_unique<DE::Problem::HybridFunction5>(
+      function = std::make_unique<DE::Problem::HybridFunction5<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 16:
-      function = std::make_unique<DE::Problem::HybridFunction6>(
+      function = std::make_unique<DE::Problem::HybridFunction6<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 17:
-      function = std::make_unique<DE::Problem::HybridFunction7>(
+      function = std::make_unique<DE::Problem::HybridFunction7<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 18:
-      function = std::make_unique<DE::Problem::HybridFunction8>(
+      function = std::make_unique<DE::Problem::HybridFunction8<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 19:
-      function = std::make_unique<DE::Problem::HybridFunction9>(
+      function = std::make_unique<DE::Problem::HybridFunction9<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 20:
-      function = std::make_unique<DE::Problem::HybridFunction10>(
+      function = std::make_unique<DE::Problem::HybridFunction10<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 21:
-      function = std::make_unique<DE::Problem::CompositionFunction1>(
+      function = std::make_unique<DE::Problem::CompositionFunction1<T>>(
           D, shift_f, rotation_f);
       break;
     case 22:
-      function = std::make_unique<DE::Problem::CompositionFunction2>(
+      function = std::make_unique<DE::Problem::CompositionFunction2<T>>(
           D, shift_f, rotation_f);
       break;
     case 23:
-      function = std::make_unique<DE::Problem::CompositionFunction3>(
+      function = std::make_unique<DE::Problem::CompositionFunction3<T>>(
           D, shift_f, rotation_f);
       break;
     case 24:
-      function = std::make_unique<DE::Problem::CompositionFunction4>(
+      function = std::make_unique<DE::Problem::CompositionFunction4<T>>(
           D, shift_f, rotation_f);
       break;
     case 25:
-      function = std::make_unique<DE::Problem::CompositionFunction5>(
+      function = std::make_unique<DE::Problem::CompositionFunction5<T>>(
           D, shift_f, rotation_f);
       break;
     case 26:
-      function = std::make_unique<DE::Problem::CompositionFunction6>(
+      function = std::make_unique<DE::Problem::CompositionFunction6<T>>(
           D, shift_f, rotation_f);
       break;
     case 27:
-      function = std::make_unique<DE::Problem::CompositionFunction7>(
+      function = std::make_unique<DE::Problem::CompositionFunction7<T>>(
           D, shift_f, rotation_f);
       break;
     case 28:
-      function = std::make_unique<DE::Problem::CompositionFunction8>(
+      function = std::make_unique<DE::Problem::CompositionFunction8<T>>(
           D, shift_f, rotation_f);
       break;
     case 29:
-      function = std::make_unique<DE::Problem::CompositionFunction9>(
+      function = std::make_unique<DE::Problem::CompositionFunction9<T>>(
           D, shift_f, rotation_f, shuffle_f);
       break;
     case 30:
-      function = std::make_unique<DE::Problem::CompositionFunction10>(
+      function = std::make_unique<DE::Problem::CompositionFunction10<T>>(
           D, shift_f, rotation_f, shuffle_f);
       break;
   }
@@ -9,16 +9,156 @@
 #ifndef DE_CEC_BASIC_PROBLEM_HPP
 #define DE_CEC_BASIC_PROBLEM_HPP
 
+#include <algorithm>
 #include <vector>
 #include <map>
+#include <memory>
 #include <assert.h>
 #include <cstdio>
 #include <stdexcept>
+#include "dimension.hpp"
+#include "problem/cec_data_registry.hpp"
 #include "problem/simple_problem.hpp"
+#include "simd.hpp"
 
 namespace DE {
 namespace Problem {
 
+namespace detail {
+
+/*!
+ * \brief y = M ((x - shift) scale), with row j of \p rotation holding column j
+ *        of M
+ *
+ * Row j is multiplied by the j-th gene and added to y, which vectorizes
+ * along the rows while every output adds its products in the order of a
+ * row by column loop.
+ *
+ * \param x        : The chromosome, of \p D genes
+ * \param shift    : The shift, or nullptr
+ * \param scale    : The scale factor
+ * \param rotation : The transposed rotation matrix
+ * \param stride   : Distance in elements between two rows of \p rotation
+ * \param D        : Number of genes
+ * \param y        : Output, \p D genes
+ */
+
+template <class T>
+void transform(const T* x, const T* shift, const T scale, const T* rotation,
+               const std::size_t stride, const std::size_t D, T* y) {
+  std::fill(y, y + D, T(0));
+  for (std::size_t j = 0; j < D; ++j) {
+    const T x_j = (shift ? x[j] - shift[j] : x[j]) * scale;
+    const T* row = rotation + j * stride;
+    for (std::size_t i = 0; i < D; ++i)
+      y[i] += x_j * row[i];
+  }
+}
+
+/*! On doubles the vector kernel computes the same, \see SIMD::Kernels */
+inline void transform(const double* x, const double* shift,
+                      const double scale, const double* rotation,
+                      const std::size_t stride, const std::size_t D,
+                      double* y) {
+  if (SIMD::enabled())
+    SIMD::kernels().transform(x, shift, scale, rotation, stride, D, y);
+  else
+    transform<double>(x, shift, scale, rotation, stride, D, y);
+}
+
+/*! On floats the vector kernel computes the same, \see SIMD::FloatKernels */
+inline void transform(const float* x, const float* shift, const float scale,
+                      const float* rotation, const std::size_t stride,
+                      const std::size_t D, float* y) {
+  if (SIMD::enabled())
+    SIMD::float_kernels().transform(x, shift, scale, rotation, stride, D, y);
+  else
+    transform<float>(x, shift, scale, rotation, stride, D, y);
+}
+
+/*!
+ * \brief Rotate a block of chromosomes, as transform without shift and scale
+ *
+ * \param x        : The chromosomes, of \p D genes each
+ * \param x_stride : Distance in elements between two chromosomes of \p x
+ * \param rows     : Number of chromosomes
+ * \param rotation : The transposed rotation matrix
+ * \param stride   : Distance in elements between two rows of \p rotation
+ * \param D        : Number of genes
+ * \param y        : Output, the rotated chromosomes, padded with zeros
+ * \param y_stride : Distance in elements between two chromosomes of \p y, at
+ *                   least Matrix<T>::padded_size(D)
+ */
+
+template <class T>
+void rotate_batch(const T* x, const std::size_t x_stride,
+                  const std::size_t rows, const T* rotation,
+                  const std::size_t stride, const std::size_t D, T* y,
+                  const std::size_t y_stride) {
+  for (std::size_t r = 0; r < rows; ++r)
+    transform<T>(x + r * x_stride, nullptr, T(1), rotation, stride, D,
+                 y + r * y_stride);
+}
+
+/*! On doubles a blocked matrix product, \see SIMD::Kernels */
+inline void rotate_batch(const double* x, const std::size_t x_stride,
+                         const std::size_t rows, const double* rotation,
+                         const std::size_t stride, const std::size_t D,
+                         double* y, const std::size_t y_stride) {
+  if (SIMD::enabled())
+    SIMD::kernels().rotate_batch(x, x_stride, rows, rotation, stride, D, y,
+                                 y_stride);
+  else
+    rotate_batch<double>(x, x_stride, rows, rotation, stride, D, y, y_stride);
+}
+
+/*! On floats a blocked matrix product, \see SIMD::FloatKernels */
+inline void rotate_batch(const float* x, const std::size_t x_stride,
+                         const std::size_t rows, const float* rotation,
+                         const std::size_t stride, const std::size_t D,
+                         float* y, const std::size_t y_stride) {
+  if (SIMD::enabled())
+    SIMD::float_kernels().rotate_batch(x, x_stride, rows, rotation, stride, D,
+                                       y, y_stride);
+  else
+    rotate_batch<float>(x, x_stride, rows, rotation, stride, D, y, y_stride);
+}
+
+/*!
+ * \class DoubleGenes
+ * \brief Genes as doubles, for the kernels of the basic functions
+ *
+ * Doubles are pointed to; any other type is copied into a scratch buffer.
+ */
+
+template <class T>
+class DoubleGenes {
+ public:
+  explicit DoubleGenes(ConstRowView<T> x) : buffer_(x.size()) {
+    std::copy(x.begin(), x.end(), buffer_.data());
+    genes_ = buffer_.data();
+  }
+
+  const double* data() const { return genes_; }
+
+ private:
+  ScratchVector<double> buffer_;
+  const double* genes_;
+};
+
+template <>
+class DoubleGenes<double> {
+ public:
+  explicit DoubleGenes(ConstRowView<double> x) : genes_(x.data()) {}
+
+  const double* data() const { return genes_; }
+
+ private:
+  const double* genes_;
+};
+
+}  // namespace detail
+
 /*! \class CECFunction
  *  \brief A wrapper of Base for fitness functions based on CEC-2015
  *
@@ -33,28 +173,49 @@ class CECFunction : public SimpleFitnessFunction<T> {
  public:
   CECFunction(const std::size_t D, const char* name)
       : SimpleFitnessFunction<T>(D, name) {
-    for (std::size_t i = 0; i < Base<T>::D_; ++i)
-      SimpleFitnessFunction<T>::constrains_.insert(
-          std::make_pair(i, Constrain<double>(-100, 100)));
+    SimpleFitnessFunction<T>::set_bounds(-100, 100);
   };
 
-  double fitness(const std::vector<T>& chromosome) const {
+  double fitness(ConstRowView<T> chromosome) const {
     assert(chromosome.size() == Base<T>::D_);
-    if (shift_.empty() && rotation_.empty() && scale_ == 1.0)
+    if ((!shift_ && !rotation_ && scale_ == 1.0) ||
+        handle_shift_and_rotation_internally_)
       return evaluate(chromosome);
-    if (handle_shift_and_rotation_internally_)
-      return evaluate(chromosome);
-    std::vector<T> transformed = chromosome;
-    if (!shift_.empty())
-      transformed = shift(chromosome);
-    if (scale_ != 1.0)
-      for (auto& gene : transformed)
-        gene *= scale_;
-    if (!rotation_.empty())
-      transformed = rotate(transformed);
-    return evaluate(transformed);
+    return with_dimension(Base<T>::D_, [&](const auto D) {
+      GeneBuffer<T, decltype(D)> transformed(D);
+      transform_padded(chromosome.data(), D, transformed.data());
+      return evaluate(ConstRowView<T>(transformed.data(), D));
+    });
   };
 
+  /*!
+   * \brief Calculate the fitness of a block of chromosomes
+   *
+   * The block is transformed in chunks of batch_rows_ chromosomes with
+   * transform_batch, which are then evaluated with evaluate_batch. The
+   * results are identical to calling fitness on each chromosome.
+   *
+   * \param chromosomes : The chromosomes to be evaluated, one per row
+   * \param fitness     : Output, one value per row of \p chromosomes
+   */
+
+  void fitness_batch(ConstBlockView<T> chromosomes, double* fitness) const {
+    assert(chromosomes.cols() == Base<T>::D_);
+    if ((!shift_ && !rotation_ && scale_ == 1.0) ||
+        handle_shift_and_rotation_internally_)
+      return evaluate_batch(chromosomes, fitness);
+    const std::size_t D = Base<T>::D_, stride = Matrix<T>::padded_size(D);
+    const std::size_t rows = std::min(chromosomes.rows(), batch_rows_);
+    ScratchVector<T> transformed(rows * stride);
+    for (std::size_t first = 0; first < chromosomes.rows(); first += rows) {
+      const auto chunk =
+          chromosomes.slice(first, std::min(rows, chromosomes.rows() - first));
+      BlockView<T> t(transformed.data(), chunk.rows(), D, stride);
+      transform_batch(chunk, t);
+      evaluate_batch(t, fitness + first);
+    }
+  }
+
   /*!
    * \brief Evaluate the function on the chromosome
    *
@@ -63,11 +224,29 @@ class CECFunction : public SimpleFitnessFunction<T> {
    * \return The mathematical function's result for this vector
    */
 
-  virtual double evaluate(const std::vector<T>& chromosome) const = 0;
+  virtual double evaluate(ConstRowView<T> chromosome) const = 0;
+
+  /*!
+   * \brief Evaluate the function on a block of (transformed) chromosomes
+   *
+   * \param chromosomes : The chromosomes, one per row
+   * \param fitness     : Output, one value per row of \p chromosomes
+   */
+
+  virtual void evaluate_batch(ConstBlockView<T> chromosomes,
+                              double* fitness) const {
+    for (std::size_t i = 0; i < chromosomes.rows(); ++i)
+      fitness[i] = evaluate(chromosomes[i]);
+  }
 
   /*!
    * \brief Parse the shift file (shift_data_*.txt) generated by the .m file
    *
+   * The shift is loaded once per process (\see CECDataRegistry) and shared
+   * with every function parsing the same row of the same file. If the
+   * directory of the file holds a data pack (\see CECDataPack) with the file,
+   * the shift points into the pack instead of being parsed.
+   *
    * \param shift_file    : Path to the .txt file
    * \param skip_rows     : If specified, skip this many rows
    *
@@ -76,20 +255,17 @@ class CECFunction : public SimpleFitnessFunction<T> {
 
   void parse_shift_file(const char* shift_file,
                         const std::size_t skip_rows = 0) {
-    shift_.resize(Base<T>::D_);
-    FILE* fpt = fopen(shift_file, "r");
-    if (fpt == NULL)
-      throw std::runtime_error("Unable to open shift file");
-    if (skip_rows > 0)
-      forward_file_pointer(fpt, skip_rows);
-    for (std::size_t i = 0; i < Base<T>::D_; ++i)
-      fscanf(fpt, "%lf", &shift_[i]);
-    fclose(fpt);
+    shift_ = CECDataRegistry<T>::shift(shift_file, skip_rows, Base<T>::D_);
   }
 
   /*!
    * \brief Parse the rotation file (M_*.txt) generated by the .m file
    *
+   * The matrix is loaded once per process (\see CECDataRegistry) and shared
+   * with every function parsing the same rows of the same file. If the
+   * directory of the file holds a data pack (\see CECDataPack) with the file,
+   * the rotation points into the pack instead of being parsed.
+   *
    * \param rotation_file : Path to the .txt file
    * \param skip_rows     : If specified, skip this many rows
    *
@@ -98,18 +274,29 @@ class CECFunction : public SimpleFitnessFunction<T> {
 
   void parse_rotation_file(const char* rotation_file,
                            const std::size_t skip_rows = 0) {
-    rotation_.resize(Base<T>::D_);
-    for (auto& row : rotation_)
-      row.resize(Base<T>::D_);
-    FILE* fpt = fopen(rotation_file, "r");
-    if (fpt == NULL)
-      throw std::runtime_error("Unable to open rotation file");
-    if (skip_rows > 0)
-      forward_file_pointer(fpt, skip_rows);
-    for (std::size_t i = 0; i < Base<T>::D_; ++i)
-      for (std::size_t j = 0; j < Base<T>::D_; ++j)
-        fscanf(fpt, "%lf", &rotation_[i][j]);
-    fclose(fpt);
+    rotation_ =
+        CECDataRegistry<T>::rotation(rotation_file, skip_rows, Base<T>::D_);
+  }
+
+  /*!
+   * \brief Use a shift shared with other functions
+   *
+   * \param shift : D_ values, or nullptr for no shift
+   */
+
+  void set_shift_data(std::shared_ptr<const T> shift) {
+    shift_ = std::move(shift);
+  }
+
+  /*!
+   * \brief Use a rotation matrix shared with other functions
+   *
+   * \param rotation : D_ rows of Matrix<T>::padded_size(D_) values, row j
+   *                   holding column j of the matrix, or nullptr for none
+   */
+
+  void set_rotation_data(std::shared_ptr<const T> rotation) {
+    rotation_ = std::move(rotation);
   }
 
   /*!
@@ -126,14 +313,58 @@ class CECFunction : public SimpleFitnessFunction<T> {
    * \return The shifting data
    */
 
-  auto get_shift_data() const { return shift_; }
+  ConstRowView<T> get_shift_data() const {
+    return ConstRowView<T>(shift_.get(), shift_ ? Base<T>::D_ : 0);
+  }
+
+  /*!
+   * \brief Get the rotation matrix, transposed: row j holds column j
+   *
+   * \return The rotation matrix, empty if there is no rotation
+   */
+
+  ConstBlockView<T> get_rotation_data() const {
+    return ConstBlockView<T>(rotation_.get(), rotation_ ? Base<T>::D_ : 0,
+                             Base<T>::D_, Matrix<T>::padded_size(Base<T>::D_));
+  }
+
+  /*!
+   * \brief Get the rotation matrix as shared with other functions
+   *
+   * \return The storage of get_rotation_data, null if there is no rotation
+   */
+
+  std::shared_ptr<const T> get_shared_rotation_data() const {
+    return rotation_;
+  }
+
+  /*!
+   * \brief Get the scale factor of the fitness function
+   *
+   * \return The scale factor
+   */
+
+  T get_scale_factor() const { return scale_; }
+
+  /*!
+   * \brief True if evaluate shifts and rotates the chromosome itself
+   */
+
+  bool transforms_internally() const {
+    return handle_shift_and_rotation_internally_;
+  }
 
  protected:
+  /*! Number of chromosomes transformed at once by fitness_batch */
+  static constexpr std::size_t batch_rows_ = 64;
   T scale_ = 1.0; /*!< If supplied, scale the difference for each gene */
-  /*! Vector of size D_ for the shifting of each gene */
-  std::vector<T> shift_;
-  /*! Vector of size D_, D_ for the rotation of each gene */
-  std::vector<std::vector<T>> rotation_;
+  /*! Shift of each gene (D_ values), shared and immutable, or null */
+  std::shared_ptr<const T> shift_;
+  /*!
+   * Rotation matrix of size D_, D_, transposed (row j holds column j), its
+   * rows Matrix<T>::padded_size(D_) apart; shared and immutable, or null
+   */
+  std::shared_ptr<const T> rotation_;
   bool handle_shift_and_rotation_internally_ = false;
   /*!< If this is set, shift and rotation will not occur prior to calling
    * evaluate */
@@ -142,57 +373,128 @@ class CECFunction : public SimpleFitnessFunction<T> {
    * \brief Shift each gene by a pre-determined value
    *
    * \param initial : The chromosome to be shifted
-   *
-   * \return The shifted chromosome
+   * \param shifted : Output, the shifted chromosome
    */
 
-  std::vector<T> shift(const std::vector<T>& initial) const {
+  void shift(ConstRowView<T> initial, RowView<T> shifted) const {
     assert(initial.size() == Base<T>::D_);
-    assert(shift_.size() == Base<T>::D_);
-    std::vector<T> shifted(Base<T>::D_, 0);
+    assert(shifted.size() == Base<T>::D_);
+    assert(shift_);
     for (std::size_t i = 0; i < Base<T>::D_; ++i)
-      shifted[i] = initial[i] - shift_[i];
-    return shifted;
+      shifted[i] = initial[i] - shift_.get()[i];
   }
 
   /*!
    * \brief Rotate a given chromosome based on matrix
    *
    * \param initial : The chromosome to be rotated
+   * \param rotated : Output, the rotated chromosome (must not alias initial)
+   */
+
+  void rotate(ConstRowView<T> initial, RowView<T> rotated) const {
+    assert(initial.size() == Base<T>::D_);
+    assert(rotated.size() == Base<T>::D_);
+    assert(rotation_);
+    assert(initial.data() != rotated.data());
+    detail::transform(initial.data(), nullptr, T(1), rotation_.get(),
+                      Matrix<T>::padded_size(Base<T>::D_), Base<T>::D_,
+                      rotated.data());
+  }
+
+  /*!
+   * \brief Shift, scale and rotate a chromosome in a single pass
+   *
+   * Each gene is shifted and scaled as the product with the rotation matrix
+   * reads it, so no intermediate vector is stored. The products of every
+   * output are added in the same order as a plain row by column loop.
    *
-   * \return The rotated chromosome
+   * \param initial     : The chromosome to be transformed
+   * \param transformed : Output, the transformed chromosome (must not alias
+   *                      initial)
    */
 
-  std::vector<T> rotate(const std::vector<T>& initial) const {
+  void transform(ConstRowView<T> initial, RowView<T> transformed) const {
     assert(initial.size() == Base<T>::D_);
-    assert(rotation_.size() == Base<T>::D_);
-    std::vector<T> rotated(Base<T>::D_, 0);
-    for (std::size_t i = 0; i < Base<T>::D_; ++i)
-      for (std::size_t j = 0; j < Base<T>::D_; ++j)
-        rotated[i] += initial[j] * rotation_[i][j];
-    return rotated;
+    assert(transformed.size() >= Base<T>::D_);
+    assert(initial.data() != transformed.data());
+    const T* shift = shift_.get();
+    if (!rotation_) {
+      for (std::size_t i = 0; i < Base<T>::D_; ++i)
+        transformed[i] = (shift ? initial[i] - shift[i] : initial[i]) * scale_;
+      return;
+    }
+    detail::transform(initial.data(), shift, scale_, rotation_.get(),
+                      Matrix<T>::padded_size(Base<T>::D_), Base<T>::D_,
+                      transformed.data());
+  }
+
+  /*!
+   * \brief Shift, scale and rotate a chromosome into a padded buffer
+   *
+   * As transform, but the rotation writes whole vectors, padding included,
+   * instead of finishing every row of the rotation one gene at a time.
+   *
+   * \param initial     : The chromosome
+   * \param D           : Number of genes, \see with_dimension
+   * \param transformed : Output, Matrix<T>::padded_size(D_) genes
+   */
+
+  template <class Dim>
+  void transform_padded(const T* initial, const Dim D, T* transformed) const {
+    const T* shift = shift_.get();
+    if (!rotation_) {
+      for (std::size_t i = 0; i < D; ++i)
+        transformed[i] = (shift ? initial[i] - shift[i] : initial[i]) * scale_;
+      return;
+    }
+    const std::size_t stride = Matrix<T>::padded_size(D);
+    GeneBuffer<T, Dim> shifted(D);
+    for (std::size_t i = 0; i < D; ++i)
+      shifted[i] = (shift ? initial[i] - shift[i] : initial[i]) * scale_;
+    detail::rotate_batch(shifted.data(), stride, 1, rotation_.get(), stride, D,
+                         transformed, stride);
   }
 
   /*!
-   * \brief Forward a file pointer by skipping lines
+   * \brief Shift, scale and rotate a block of chromosomes
    *
-   * Lines are determined by the newline character
+   * The block is shifted and scaled first, then multiplied by the rotation
+   * matrix as a blocked matrix-matrix product, which loads each element of
+   * the matrix once per few chromosomes instead of once per chromosome. The
+   * results equal those of transform.
    *
-   * \param fpt  : The file pointer to be forwarded
-   * \param skip : Number of lines to be skipped
+   * \param initial     : The chromosomes to be transformed, one per row
+   * \param transformed : Output, as many rows as \p initial, with a stride of
+   *                      at least Matrix<T>::padded_size(D_)
    */
 
-  void forward_file_pointer(FILE* fpt, const std::size_t skip) {
-    assert(fpt != nullptr);
-    char tmp_char;
-    for (std::size_t i = 0; i < skip; ++i) {
-      fscanf(fpt, "%c", &tmp_char);
-      while (tmp_char != '\n') {
-        fscanf(fpt, "%c", &tmp_char);
-      }
+  void transform_batch(ConstBlockView<T> initial,
+                       BlockView<T> transformed) const {
+    assert(initial.cols() == Base<T>::D_);
+    assert(transformed.rows() == initial.rows());
+    const std::size_t D = Base<T>::D_, stride = Matrix<T>::padded_size(D);
+    assert(transformed.stride() >= stride);
+    if (!rotation_) {
+      for (std::size_t r = 0; r < initial.rows(); ++r)
+        transform(initial[r], transformed[r]);
+      return;
+    }
+    ScratchVector<T> shifted(initial.rows() * stride);
+    const T* shift = shift_.get();
+    for (std::size_t r = 0; r < initial.rows(); ++r) {
+      T* row = shifted.data() + r * stride;
+      for (std::size_t i = 0; i < D; ++i)
+        row[i] = (shift ? initial[r][i] - shift[i] : initial[r][i]) * scale_;
     }
+    detail::rotate_batch(shifted.data(), stride, initial.rows(),
+                         rotation_.get(), stride, D, transformed.data(),
+                         transformed.stride());
   }
 };
+
+template <class T>
+constexpr std::size_t CECFunction<T>::batch_rows_;
+
 }  // namespace Problem
 }  // namespace DE
 #endif  // DE_CEC_BASIC_PROBLEM_HPP
@@ -15,6 +15,7 @@
 #include <cstdio>
 #include <limits>
 #include <algorithm>
+#include <cmath>
 #include "problem/simple_problem.hpp"
 #include "problem/cec_basic_problem.hpp"
 
@@ -25,59 +26,258 @@ template <class T>
 class CECComposition : public CECFunction<T> {
  public:
   CECComposition(const std::size_t D, const char* name)
-      : CECFunction<T>(D, name) {
-    // Constrains
-    for (std::size_t i = 0; i < Base<T>::D_; ++i)
-      SimpleFitnessFunction<T>::constrains_.insert(
-          std::make_pair(i, Constrain<double>(-100, 100)));
-  };
+      : CECFunction<T>(D, name){};
 
-  double evaluate(const std::vector<T>& chromosome) const {
+  double evaluate(ConstRowView<T> chromosome) const {
     assert(chromosome.size() == Base<T>::D_);
-    thread_local std::vector<double> fitness, weights;
-    fitness.resize(functions_.size());
-    weights.resize(functions_.size());
-    for (std::size_t i = 0; i < functions_.size(); ++i) {
-      fitness[i] =
-          functions_[i].lambda * functions_[i].func->fitness(chromosome) +
-          functions_[i].bias;
-      const auto& shift = functions_[i].func->get_shift_data();
-      assert(shift.size() == Base<T>::D_);
-      weights[i] = 0;
-      for (std::size_t j = 0; j < Base<T>::D_; ++j)
-        weights[i] += pow(chromosome[j] - shift[j], 2.0);
-      if (weights[i] == 0)
-        weights[i] = std::numeric_limits<double>::max();
-      else
-        weights[i] = pow(1.0 / weights[i], 0.5) *
-                     exp(-1.0 * weights[i] / 2.0 / Base<T>::D_ /
-                         pow(functions_[i].sigma, 2.0));
-    }
-    double weights_sum = std::accumulate(weights.begin(), weights.end(), 0.0);
-    if (weights_sum == 0.0) {
-      for (auto& w : weights)
-        w = 1.0;
-      weights_sum = functions_.size();
+    return with_dimension(Base<T>::D_, [&](const auto D) {
+      return evaluate(chromosome.data(), D);
+    });
+  }
+
+  /*!
+   * \brief Evaluate the composition function on a block of chromosomes
+   *
+   * In chunks of batch_rows_ chromosomes, the weights of every chromosome
+   * are computed first; then every basic function with a weight other than
+   * zero transforms and evaluates the whole chunk at once.
+   *
+   * \param chromosomes : The chromosomes, one per row
+   * \param fitness     : Output, one value per row of \p chromosomes
+   */
+
+  void evaluate_batch(ConstBlockView<T> chromosomes, double* fitness) const {
+    assert(chromosomes.cols() == Base<T>::D_);
+    const std::size_t D = Base<T>::D_, K = functions_.size();
+    const std::size_t stride = Matrix<T>::padded_size(D);
+    const std::size_t rows = std::min(chromosomes.rows(), batch_rows_);
+    // Row-major [rows, K] table of the weights
+    ScratchVector<double> weights(rows * K), weights_sum(rows), f(rows);
+    ScratchVector<T> shifted(rows * stride), transformed(rows * stride);
+    for (std::size_t first = 0; first < chromosomes.rows(); first += rows) {
+      const auto chunk =
+          chromosomes.slice(first, std::min(rows, chromosomes.rows() - first));
+      const std::size_t n = chunk.rows();
+      double* fit_sum = fitness + first;
+      for (std::size_t r = 0; r < n; ++r) {
+        weights_sum[r] = weigh(chunk[r].data(), weights.data() + r * K);
+        fit_sum[r] = 0.0;
+      }
+      for (std::size_t i = 0; i < K; ++i) {
+        bool needed = !skip_zero_weights_;
+        for (std::size_t r = 0; r < n && !needed; ++r)
+          needed = weights[r * K + i] / weights_sum[r] != 0.0;
+        if (!needed)
+          continue;
+        if (tabled_[i]) {
+          for (std::size_t r = 0; r < n; ++r)
+            for (std::size_t j = 0; j < D; ++j)
+              shifted[r * stride + j] =
+                  (chunk[r][j] - shifts_[i][j]) * scales_[i];
+          detail::rotate_batch(shifted.data(), stride, n,
+                               rotations_.get() + i * rotation_block_,
+                               rotation_stride_, D, transformed.data(),
+                               stride);
+          functions_[i].func->evaluate_batch(
+              BlockView<T>(transformed.data(), n, D, stride), f.data());
+        } else {
+          functions_[i].func->fitness_batch(chunk, f.data());
+        }
+        for (std::size_t r = 0; r < n; ++r) {
+          const double weight = weights[r * K + i] / weights_sum[r];
+          if (weight == 0.0 && skip_zero_weights_)
+            continue;
+          fit_sum[r] +=
+              weight * (functions_[i].lambda * f[r] + functions_[i].bias);
+        }
+      }
     }
-    double fit_sum = 0.0;
-    for (std::size_t i = 0; i < functions_.size(); ++i)
-      fit_sum += weights[i] / weights_sum * fitness[i];
-    return fit_sum;
   }
 
+  /*!
+   * \brief Skip the basic functions whose normalized weight is zero
+   *
+   * Their terms add nothing, unless the basic function is infinite or NaN
+   * at the chromosome. On by default.
+   *
+   * \param skip : If true, skip them
+   */
+
+  void set_skip_zero_weights(const bool skip) { skip_zero_weights_ = skip; }
+
  protected:
   struct BasicFunction {
-    CECFunction<double>* func;
+    CECFunction<T>* func;
     double sigma;
     double lambda;
     double bias;
 
-    BasicFunction(CECFunction<double>* f, double s, double l, double b)
+    BasicFunction(CECFunction<T>* f, double s, double l, double b)
         : func(f), sigma(s), lambda(l), bias(b){};
   };
 
   std::vector<BasicFunction> functions_;
+
+  /*!
+   * \brief Gather the shifts, scales and rotations of the basic functions
+   *
+   * Must be called once functions_ is set and their shift and rotation
+   * files are parsed. The shifts form a flat table, and the transposed
+   * rotations are stacked one below the other into a (K D_) x D_ matrix;
+   * if the basic functions point into a data pack where their rotations are
+   * stacked already, the matrix is that of the pack and nothing is copied.
+   * A missing shift counts as zero. Basic functions without a rotation, or
+   * that shift and rotate the chromosome themselves, are evaluated through
+   * their own fitness.
+   */
+
+  void build_tables() {
+    const std::size_t D = Base<T>::D_, K = functions_.size();
+    rotation_stride_ = Matrix<T>::padded_size(D);
+    rotation_block_ = D * rotation_stride_;
+    shifts_ = Matrix<T>(K, D);
+    shifts_by_gene_ = Matrix<T>(D, K);
+    scales_.assign(K, T(1));
+    sigmas_.resize(K);
+    tabled_.assign(K, false);
+    for (std::size_t i = 0; i < K; ++i) {
+      const auto& func = *functions_[i].func;
+      const auto& shift = func.get_shift_data();
+      assert(shift.empty() || shift.size() == D);
+      for (std::size_t j = 0; j < D && !shift.empty(); ++j)
+        shifts_[i][j] = shifts_by_gene_[j][i] = shift[j];
+      sigmas_[i] = pow(functions_[i].sigma, 2.0);
+      if (func.get_rotation_data().empty() || func.transforms_internally())
+        continue;
+      tabled_[i] = true;
+      scales_[i] = func.get_scale_factor();
+    }
+    const T* first = functions_[0].func->get_rotation_data().data();
+    bool stacked = true;
+    for (std::size_t i = 0; i < K && stacked; ++i)
+      stacked = tabled_[i] && functions_[i].func->get_rotation_data().data() ==
+                                  first + i * rotation_block_;
+    if (stacked) {
+      rotations_ = functions_[0].func->get_shared_rotation_data();
+      return;
+    }
+    auto rotations = std::make_shared<Matrix<T>>(K * D, D);
+    for (std::size_t i = 0; i < K; ++i) {
+      if (!tabled_[i])
+        continue;
+      const auto rotation = functions_[i].func->get_rotation_data();
+      for (std::size_t j = 0; j < D; ++j)
+        std::copy(rotation[j].begin(), rotation[j].end(),
+                  (*rotations)[i * D + j].begin());
+    }
+    rotations_ = std::shared_ptr<const T>(rotations, rotations->data());
+  }
+
+ private:
+  /*! Number of chromosomes evaluated at once by evaluate_batch */
+  static constexpr std::size_t batch_rows_ = 64;
+  /*! Shifts of the basic functions, one per row */
+  Matrix<T> shifts_;
+  /*! The same shifts, one gene per row */
+  Matrix<T> shifts_by_gene_;
+  /*!
+   * The transposed rotations, one below the other, rotation_block_ apart;
+   * their rows are rotation_stride_ apart
+   */
+  std::shared_ptr<const T> rotations_;
+  std::size_t rotation_block_ = 0;
+  std::size_t rotation_stride_ = 0;
+  /*! Scale factors of the basic functions */
+  std::vector<T> scales_;
+  /*! Squares of the sigmas of the basic functions */
+  std::vector<double> sigmas_;
+  /*! True if the basic function is evaluated from the tables */
+  std::vector<bool> tabled_;
+  bool skip_zero_weights_ = true;
+
+  /*!
+   * \brief Evaluate the composition function, \see with_dimension
+   *
+   * Every basic function evaluated from the tables is shifted and scaled,
+   * then rotated a whole vector of genes at a time into padded buffers.
+   *
+   * \param x : The chromosome
+   * \param D : Number of genes
+   */
+
+  template <class Dim>
+  double evaluate(const T* x, const Dim D) const {
+    const std::size_t K = functions_.size(),
+                      stride = Matrix<T>::padded_size(D);
+    ScratchVector<double> weights(K);
+    const double weights_sum = weigh(x, weights.data());
+    GeneBuffer<T, Dim> shifted(D), transformed(D);
+    double fit_sum = 0.0;
+    for (std::size_t i = 0; i < K; ++i) {
+      const double weight = weights[i] / weights_sum;
+      if (weight == 0.0 && skip_zero_weights_)
+        continue;
+      double f;
+      if (tabled_[i]) {
+        const T* shift = shifts_[i].data();
+        for (std::size_t j = 0; j < D; ++j)
+          shifted[j] = (x[j] - shift[j]) * scales_[i];
+        detail::rotate_batch(shifted.data(), stride, 1,
+                             rotations_.get() + i * rotation_block_,
+                             rotation_stride_, D, transformed.data(), stride);
+        f = functions_[i].func->evaluate(
+            ConstRowView<T>(transformed.data(), D));
+      } else {
+        f = functions_[i].func->fitness(ConstRowView<T>(x, D));
+      }
+      fit_sum += weight * (functions_[i].lambda * f + functions_[i].bias);
+    }
+    return fit_sum;
+  }
+
+  /*!
+   * \brief The weights of the basic functions for a chromosome
+   *
+   * The distances to all the shifts are accumulated in a single pass over
+   * the genes, in the same order as one shift at a time.
+   *
+   * \param x       : The chromosome
+   * \param weights : Output, the weight of every basic function
+   *
+   * \return The sum of the weights, by which they are to be divided
+   */
+
+  double weigh(const T* x, double* weights) const {
+    assert(shifts_by_gene_.rows() == Base<T>::D_);
+    const std::size_t D = Base<T>::D_, K = functions_.size();
+    std::fill_n(weights, K, 0.0);
+    for (std::size_t j = 0; j < D; ++j) {
+      const T* shift = shifts_by_gene_[j].data();
+      for (std::size_t i = 0; i < K; ++i) {
+        const double d = x[j] - shift[i];
+        weights[i] += d * d;
+      }
+    }
+    double weights_sum = 0.0;
+    for (std::size_t i = 0; i < K; ++i) {
+      if (weights[i] == 0)
+        weights[i] = std::numeric_limits<double>::max();
+      else
+        weights[i] = std::sqrt(1.0 / weights[i]) *
+                     exp(-1.0 * weights[i] / 2.0 / D / sigmas_[i]);
+      weights_sum += weights[i];
+    }
+    if (weights_sum == 0.0) {
+      std::fill_n(weights, K, 1.0);
+      weights_sum = K;
+    }
+    return weights_sum;
+  }
 };
+
+template <class T>
+constexpr std::size_t CECComposition<T>::batch_rows_;
+
 }  // namespace Problem
 }  // namespace DE
 #endif  // DE_CEC_COMPOSITION_PROBLEM_HPP
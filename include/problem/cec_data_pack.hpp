@@ -0,0 +1,377 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief A binary pack of the CEC-2017 data files, mapped into memory
+ *
+ * The shift, rotation and shuffle files of CEC-2017 are text, and parsing
+ * them dominates setting up a function. CECDataPack::create converts a whole
+ * data directory once into a single binary file (see tools/pack_cec_data);
+ * afterwards the functions map that file and point straight into its pages.
+ *
+ * Layout, in native byte order (a pack is not portable across
+ * architectures):
+ *
+ * - Header: magic, version, number of tables, offset of the index.
+ * - The tables, each starting on a 64-byte boundary, as doubles.
+ * - The index: one Entry per table, sorted by name.
+ *
+ * The tables are the data files by name (e.g. "M_21_D10.txt"), one row per
+ * line. Rotation files (M_n_Dd.txt, d columns) are stored as blocks of d
+ * rows, each block transposed and padded to Matrix<double>::padded_size(d)
+ * columns, the layout of CECFunction. All other tables are stored flat.
+ */
+
+#ifndef DE_CEC_DATA_PACK_HPP
+#define DE_CEC_DATA_PACK_HPP
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "matrix.hpp"
+
+namespace DE {
+namespace Problem {
+
+/*!
+ * \class CECDataPack
+ * \brief A read-only memory mapping of a pack of CEC data files
+ */
+
+class CECDataPack {
+ public:
+  /*! Name of the pack within a data directory */
+  static constexpr const char* file_name = "cec-2017.pack";
+
+  /*!
+   * \struct Table
+   * \brief A data file within the pack
+   */
+
+  struct Table {
+    const double* data; /*!< The first value of the table */
+    std::size_t rows;   /*!< Number of rows (lines of the file) */
+    std::size_t cols;   /*!< Number of values per row */
+    std::size_t stride; /*!< Distance in doubles between two rows */
+    bool rotation;      /*!< True if stored as transposed blocks */
+  };
+
+  /*!
+   * \brief Map a pack into memory
+   *
+   * \param path : Path to the pack
+   *
+   * \throw std::runtime_error if the file cannot be mapped or is not a pack
+   */
+
+  explicit CECDataPack(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("Unable to open data pack " + path);
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < off_t(sizeof(Header))) {
+      ::close(fd);
+      throw std::runtime_error("Invalid data pack " + path);
+    }
+    size_ = info.st_size;
+    void* address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED)
+      throw std::runtime_error("Unable to map data pack " + path);
+    base_ = static_cast<const char*>(address);
+    try {
+      read_index();
+    } catch (...) {
+      munmap(const_cast<char*>(base_), size_);
+      throw;
+    }
+  }
+
+  ~CECDataPack() { munmap(const_cast<char*>(base_), size_); }
+
+  CECDataPack(const CECDataPack&) = delete;
+  CECDataPack& operator=(const CECDataPack&) = delete;
+
+  /*!
+   * \brief Find a data file
+   *
+   * \param name : Name of the file, without its directory
+   *
+   * \return The table, or nullptr if the pack does not hold the file
+   */
+
+  const Table* find(const std::string& name) const {
+    const auto it = tables_.find(name);
+    return it == tables_.end() ? nullptr : &it->second;
+  }
+
+  /*! Number of tables in the pack */
+  std::size_t size() const { return tables_.size(); }
+
+  /*!
+   * \brief The pack of a data directory, mapped once per process
+   *
+   * \param directory : The data directory, with or without a trailing '/'
+   *
+   * \return The pack, or nullptr if the directory has none
+   *
+   * \throw std::runtime_error if the directory has an invalid pack
+   */
+
+  static std::shared_ptr<const CECDataPack> open(std::string directory) {
+    if (!directory.empty() && directory.back() != '/')
+      directory.push_back('/');
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<const CECDataPack>> packs;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& cached = packs[directory];
+    if (auto pack = cached.lock())
+      return pack;
+    const std::string path = directory + file_name;
+    if (access(path.c_str(), R_OK) != 0)
+      return nullptr;
+    auto pack = std::make_shared<const CECDataPack>(path);
+    cached = pack;
+    return pack;
+  }
+
+  /*!
+   * \brief Find a data file given its path
+   *
+   * \param path  : Path to a data file
+   * \param table : Output, the table of the file, or nullptr
+   *
+   * \return The pack of the directory of \p path, or nullptr if there is no
+   *         pack or the pack does not hold the file
+   */
+
+  static std::shared_ptr<const CECDataPack> locate(const std::string& path,
+                                                   const Table*& table) {
+    const auto slash = path.rfind('/');
+    const auto pack = open(slash == std::string::npos
+                               ? std::string()
+                               : path.substr(0, slash + 1));
+    table = pack ? pack->find(path.substr(slash + 1)) : nullptr;
+    return table ? pack : nullptr;
+  }
+
+  /*!
+   * \brief Pack all the data files of a directory
+   *
+   * The shift_data_*, M_* and shuffle_data_* text files are parsed and
+   * written to a single pack.
+   *
+   * \param directory : The data directory
+   * \param path      : The pack to be written
+   *
+   * \return Number of files packed
+   *
+   * \throw std::runtime_error if a file cannot be read or written
+   */
+
+  static std::size_t create(std::string directory, const std::string& path) {
+    if (!directory.empty() && directory.back() != '/')
+      directory.push_back('/');
+    std::vector<std::string> names;
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr)
+      throw std::runtime_error("Unable to open directory " + directory);
+    while (const dirent* entry = readdir(dir)) {
+      const std::string name = entry->d_name;
+      if (is_data_file(name))
+        names.push_back(name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+      throw std::runtime_error("Unable to write data pack " + path);
+    Header header{};
+    std::memcpy(header.magic, magic(), sizeof(header.magic));
+    header.version = version;
+    header.count = names.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::vector<Entry> entries(names.size());
+    std::vector<double> values;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      Entry& entry = entries[i];
+      std::strncpy(entry.name, names[i].c_str(), sizeof(entry.name) - 1);
+      parse_text(directory + names[i], values, entry);
+      pad(out);
+      entry.offset = out.tellp();
+      write_table(out, values, entry);
+    }
+    pad(out);
+    header.index = out.tellp();
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              entries.size() * sizeof(Entry));
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out)
+      throw std::runtime_error("Unable to write data pack " + path);
+    return names.size();
+  }
+
+ private:
+  static constexpr std::uint32_t version = 1;
+  static constexpr std::size_t alignment = 64;
+
+  /*! The first 8 bytes of a pack, null included */
+  static const char* magic() { return "DECECPK"; }
+
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t count;  /*!< Number of entries */
+    std::uint64_t index;  /*!< Offset of the first entry */
+  };
+
+  struct Entry {
+    char name[48];        /*!< Name of the file, null-terminated */
+    std::uint64_t rows;   /*!< Number of rows */
+    std::uint64_t cols;   /*!< Number of values per row */
+    std::uint64_t stride; /*!< Distance in doubles between two rows */
+    std::uint64_t block;  /*!< Rows per transposed block, 0 if flat */
+    std::uint64_t offset; /*!< Offset of the first value */
+  };
+
+  const char* base_ = nullptr; /*!< The mapping */
+  std::size_t size_ = 0;       /*!< Size of the mapping in bytes */
+  std::map<std::string, Table> tables_;
+
+  void read_index() {
+    Header header;
+    std::memcpy(&header, base_, sizeof(header));
+    if (std::memcmp(header.magic, magic(), sizeof(header.magic)) != 0 ||
+        header.version != version || header.index % alignment != 0 ||
+        header.index > size_ ||
+        header.count > (size_ - header.index) / sizeof(Entry))
+      throw std::runtime_error("Invalid data pack");
+    const Entry* entries = reinterpret_cast<const Entry*>(base_ + header.index);
+    for (std::size_t i = 0; i < header.count; ++i) {
+      const Entry& e = entries[i];
+      const std::uint64_t bytes = e.rows * e.stride * sizeof(double);
+      if (e.offset % alignment != 0 || e.offset > size_ ||
+          bytes > size_ - e.offset || e.stride < e.cols ||
+          e.name[sizeof(e.name) - 1] != '\0')
+        throw std::runtime_error("Invalid data pack");
+      tables_[e.name] = Table{reinterpret_cast<const double*>(base_ + e.offset),
+                              std::size_t(e.rows), std::size_t(e.cols),
+                              std::size_t(e.stride), e.block != 0};
+    }
+  }
+
+  static bool is_data_file(const std::string& name) {
+    const auto starts = [&](const char* prefix) {
+      return name.compare(0, std::strlen(prefix), prefix) == 0;
+    };
+    return name.size() > 4 &&
+           name.compare(name.size() - 4, 4, ".txt") == 0 &&
+           (starts("shift_data_") || starts("M_") || starts("shuffle_data_"));
+  }
+
+  /*! Dimensions of a rotation file, from its name M_n_Dd.txt, or 0 */
+  static std::size_t rotation_dimensions(const std::string& name) {
+    unsigned number, D;
+    char tail[8];
+    if (std::sscanf(name.c_str(), "M_%u_D%u%7s", &number, &D, tail) == 3 &&
+        std::strcmp(tail, ".txt") == 0)
+      return D;
+    return 0;
+  }
+
+  /*! Parse a text file into values, setting the shape of entry */
+  static void parse_text(const std::string& path, std::vector<double>& values,
+                         Entry& entry) {
+    std::ifstream in(path);
+    if (!in)
+      throw std::runtime_error("Unable to open " + path);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+    values.clear();
+    std::size_t rows = 0, cols = 0;
+    bool rectangular = true;
+    const char* p = text.c_str();
+    while (*p) {
+      const char* end_of_line = std::strchr(p, '\n');
+      if (end_of_line == nullptr)
+        end_of_line = p + std::strlen(p);
+      std::size_t count = 0;
+      while (true) {
+        char* next;
+        const double value = std::strtod(p, &next);
+        if (next == p || next > end_of_line)
+          break;
+        values.push_back(value);
+        ++count;
+        p = next;
+      }
+      if (count > 0) {
+        rectangular = rectangular && (rows == 0 || count == cols);
+        cols = std::max(cols, count);
+        ++rows;
+      }
+      p = *end_of_line ? end_of_line + 1 : end_of_line;
+    }
+    if (!rectangular || rows == 0) {  // Stored as a single row
+      rows = values.empty() ? 0 : 1;
+      cols = values.size();
+    }
+    const std::size_t D = rotation_dimensions(entry.name);
+    entry.rows = rows;
+    entry.cols = cols;
+    if (D != 0 && cols == D && rows % D == 0) {
+      entry.block = D;
+      entry.stride = Matrix<double>::padded_size(D);
+    } else {
+      entry.block = 0;
+      entry.stride = cols;
+    }
+  }
+
+  /*! Write the values of a table in the layout of its entry */
+  static void write_table(std::ofstream& out, const std::vector<double>& values,
+                          const Entry& entry) {
+    if (entry.block == 0) {
+      out.write(reinterpret_cast<const char*>(values.data()),
+                values.size() * sizeof(double));
+      return;
+    }
+    const std::size_t D = entry.block;
+    std::vector<double> block(D * entry.stride, 0.0);
+    for (std::size_t first = 0; first < entry.rows; first += D) {
+      for (std::size_t i = 0; i < D; ++i)
+        for (std::size_t j = 0; j < D; ++j)
+          block[j * entry.stride + i] = values[(first + i) * D + j];
+      out.write(reinterpret_cast<const char*>(block.data()),
+                block.size() * sizeof(double));
+    }
+  }
+
+  static void pad(std::ofstream& out) {
+    static const char zeros[alignment] = {};
+    const std::size_t position = out.tellp();
+    out.write(zeros, (alignment - position % alignment) % alignment);
+  }
+};
+
+}  // namespace Problem
+}  // namespace DE
+#endif  // DE_CEC_DATA_PACK_HPP
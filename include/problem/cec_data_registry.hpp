@@ -0,0 +1,321 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief The shift, rotation and shuffle data of the CEC functions, loaded
+ *        once per process and shared
+ *
+ * Every instance of a CEC function used to parse its own copy of the data
+ * files, although runs of the same function and dimensions (in the same
+ * thread or not) need the very same data. CECDataRegistry loads each of
+ * them once, from the data pack of the directory (\see CECDataPack) or from
+ * the text file, and hands out reference-counted handles to the immutable
+ * data. Handles may be shared freely between threads.
+ */
+
+#ifndef DE_CEC_DATA_REGISTRY_HPP
+#define DE_CEC_DATA_REGISTRY_HPP
+
+#include <assert.h>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "matrix.hpp"
+#include "problem/cec_data_pack.hpp"
+
+namespace DE {
+namespace Problem {
+
+/*!
+ * \class CECDataRegistry
+ * \brief Loads the data of the CEC functions once and shares it
+ *
+ * The data are kept until clear() is called, so that consecutive runs on the
+ * same function do not load them again; a handle outlives clear().
+ *
+ * \tparam T : Type of the shift and rotation values
+ */
+
+template <typename T>
+class CECDataRegistry {
+ public:
+  /*!
+   * \brief The shift of a function
+   *
+   * \param file      : Path to the shift file (shift_data_*.txt)
+   * \param skip_rows : Row of the file holding the shift
+   * \param D         : Dimensions
+   *
+   * \return D values
+   *
+   * \throw std::runtime_error if the file cannot be opened or holds too
+   *        few values; nothing is held then
+   */
+
+  static std::shared_ptr<const T> shift(const std::string& file,
+                                        const std::size_t skip_rows,
+                                        const std::size_t D) {
+    return find_or_load<T>(Key(shift_data, file, skip_rows, D),
+                           [&] { return load_shift(file, skip_rows, D); });
+  }
+
+  /*!
+   * \brief The rotation matrix of a function
+   *
+   * \param file      : Path to the rotation file (M_*.txt)
+   * \param skip_rows : First row of the file holding the matrix
+   * \param D         : Dimensions
+   *
+   * \return D rows of Matrix<T>::padded_size(D) values, row j holding
+   *         column j of the matrix (\see CECFunction)
+   *
+   * \throw std::runtime_error if the file cannot be opened or holds too
+   *        few values; nothing is held then
+   */
+
+  static std::shared_ptr<const T> rotation(const std::string& file,
+                                           const std::size_t skip_rows,
+                                           const std::size_t D) {
+    return find_or_load<T>(Key(rotation_data, file, skip_rows, D),
+                           [&] { return load_rotation(file, skip_rows, D); });
+  }
+
+  /*!
+   * \brief The shuffle of a hybrid function
+   *
+   * \param file   : Path to the shuffle file (shuffle_data_*.txt)
+   * \param offset : Number of values of the file to skip
+   * \param D      : Dimensions
+   *
+   * \return D values, from 1 to D as in the file
+   *
+   * \throw std::runtime_error if the file cannot be opened or holds too
+   *        few values; nothing is held then
+   */
+
+  static std::shared_ptr<const std::vector<std::size_t>> shuffle(
+      const std::string& file,
+      const std::size_t offset,
+      const std::size_t D) {
+    return find_or_load<std::vector<std::size_t>>(
+        Key(shuffle_data, file, offset, D),
+        [&] { return load_shuffle(file, offset, D); });
+  }
+
+  /*! Number of data held, including those being loaded */
+  static std::size_t size() {
+    std::lock_guard<std::mutex> lock(mutex());
+    return entries().size();
+  }
+
+  /*! Release the data held; the handles already given remain valid */
+  static void clear() {
+    std::lock_guard<std::mutex> lock(mutex());
+    entries().clear();
+  }
+
+ private:
+  enum Kind { shift_data, rotation_data, shuffle_data };
+  using Key = std::tuple<Kind, std::string, std::size_t, std::size_t>;
+
+  /*! The data of a key, once loaded */
+  struct Entry {
+    std::mutex mutex;                 /*!< Held while loading */
+    std::shared_ptr<const void> data; /*!< nullptr until loaded */
+  };
+
+  /*! Guards the map of entries, not their data */
+  static std::mutex& mutex() {
+    static std::mutex m;
+    return m;
+  }
+
+  static std::map<Key, std::shared_ptr<Entry>>& entries() {
+    static std::map<Key, std::shared_ptr<Entry>> e;
+    return e;
+  }
+
+  /*!
+   * \brief The data of a key, loaded if not held yet
+   *
+   * Only the lock of the entry is held while loading: concurrent requests
+   * for the same data wait for it instead of loading it again, while other
+   * data load in parallel. An entry whose load throws is removed, so that
+   * nothing is held for it and the next request tries again.
+   */
+
+  template <typename U, typename Load>
+  static std::shared_ptr<const U> find_or_load(const Key& key, Load load) {
+    std::shared_ptr<Entry> entry;
+    {
+      std::lock_guard<std::mutex> lock(mutex());
+      auto& held = entries()[key];
+      if (!held)
+        held = std::make_shared<Entry>();
+      entry = held;
+    }
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    if (!entry->data) {
+      try {
+        entry->data = load();
+      } catch (...) {
+        std::lock_guard<std::mutex> map_lock(mutex());
+        const auto it = entries().find(key);
+        if (it != entries().end() && it->second == entry)
+          entries().erase(it);
+        throw;
+      }
+    }
+    return std::static_pointer_cast<const U>(entry->data);
+  }
+
+  static std::shared_ptr<const T> load_shift(const std::string& file,
+                                             const std::size_t skip_rows,
+                                             const std::size_t D) {
+    const CECDataPack::Table* table;
+    const auto pack = CECDataPack::locate(file, table);
+    if (pack && !table->rotation && table->cols >= D &&
+        skip_rows < table->rows)
+      return share(pack, table->data + skip_rows * table->stride, 1, D, D,
+                   std::is_same<T, double>());
+    std::vector<double> values(D);
+    FILE* fpt = fopen(file.c_str(), "r");
+    if (fpt == NULL)
+      throw std::runtime_error("Unable to open shift file");
+    forward_file_pointer(fpt, skip_rows);
+    bool read = true;
+    for (std::size_t i = 0; i < D && read; ++i)
+      read = scan(fpt, values[i]);
+    fclose(fpt);
+    if (!read)
+      throw std::runtime_error("Unable to read shift file");
+    return share(nullptr, values.data(), 1, D, D, std::false_type());
+  }
+
+  static std::shared_ptr<const T> load_rotation(const std::string& file,
+                                                const std::size_t skip_rows,
+                                                const std::size_t D) {
+    const CECDataPack::Table* table;
+    const auto pack = CECDataPack::locate(file, table);
+    if (pack && table->rotation && table->cols == D && skip_rows % D == 0 &&
+        skip_rows < table->rows)
+      return share(pack, table->data + skip_rows * table->stride, D, D,
+                   table->stride, std::is_same<T, double>());
+    // Transposed while parsed
+    std::vector<double> values(D * D);
+    FILE* fpt = fopen(file.c_str(), "r");
+    if (fpt == NULL)
+      throw std::runtime_error("Unable to open rotation file");
+    forward_file_pointer(fpt, skip_rows);
+    bool read = true;
+    for (std::size_t i = 0; i < D && read; ++i)
+      for (std::size_t j = 0; j < D && read; ++j)
+        read = scan(fpt, values[j * D + i]);
+    fclose(fpt);
+    if (!read)
+      throw std::runtime_error("Unable to read rotation file");
+    return share(nullptr, values.data(), D, D, D, std::false_type());
+  }
+
+  static std::shared_ptr<const std::vector<std::size_t>> load_shuffle(
+      const std::string& file,
+      std::size_t offset,
+      const std::size_t D) {
+    auto shuffle = std::make_shared<std::vector<std::size_t>>(D);
+    const CECDataPack::Table* table;
+    const auto pack = CECDataPack::locate(file, table);
+    if (pack && !table->rotation && offset + D <= table->rows * table->cols) {
+      std::copy(table->data + offset, table->data + offset + D,
+                shuffle->begin());
+      return shuffle;
+    }
+    FILE* fpt = fopen(file.c_str(), "r");
+    if (fpt == NULL)
+      throw std::runtime_error("Unable to open shuffle file");
+    bool read = true;
+    while (read && offset-- != 0)
+      read = scan(fpt, (*shuffle)[0]);
+    for (std::size_t i = 0; i < D && read; ++i)
+      read = scan(fpt, (*shuffle)[i]);
+    fclose(fpt);
+    if (!read)
+      throw std::runtime_error("Unable to read shuffle file");
+    return shuffle;
+  }
+
+  /*!
+   * \brief Read the next value of a file
+   *
+   * \return false at the end of the file or on anything but a number
+   */
+
+  static bool scan(FILE* fpt, double& value) {
+    return fscanf(fpt, "%lf", &value) == 1;
+  }
+
+  static bool scan(FILE* fpt, std::size_t& value) {
+    return fscanf(fpt, "%lu", &value) == 1;
+  }
+
+  /*!
+   * \brief Forward a file pointer by skipping lines
+   *
+   * Lines are determined by the newline character
+   *
+   * \param fpt  : The file pointer to be forwarded
+   * \param skip : Number of lines to be skipped
+   */
+
+  static void forward_file_pointer(FILE* fpt, const std::size_t skip) {
+    assert(fpt != nullptr);
+    for (std::size_t i = 0; i < skip; ++i) {
+      int c;
+      while ((c = fgetc(fpt)) != '\n' && c != EOF) {
+      }
+    }
+  }
+
+  /*!
+   * \brief Share doubles as T
+   *
+   * Doubles of a pack are pointed to, keeping the pack mapped; anything
+   * else is copied into a Matrix<T>.
+   *
+   * \param pack   : The pack holding \p data, or nullptr
+   * \param data   : First value
+   * \param rows   : Number of rows
+   * \param cols   : Number of values per row
+   * \param stride : Distance in doubles between two rows of \p data, equal
+   *                 to Matrix<T>::padded_size(cols) for a pack if rows > 1
+   */
+
+  static std::shared_ptr<const double> share(
+      const std::shared_ptr<const CECDataPack>& pack, const double* data,
+      const std::size_t, const std::size_t, const std::size_t,
+      std::true_type) {
+    return std::shared_ptr<const double>(pack, data);
+  }
+
+  static std::shared_ptr<const T> share(
+      const std::shared_ptr<const CECDataPack>&, const double* data,
+      const std::size_t rows, const std::size_t cols,
+      const std::size_t stride, std::false_type) {
+    auto matrix = std::make_shared<Matrix<T>>(rows, cols);
+    for (std::size_t i = 0; i < rows; ++i)
+      std::copy(data + i * stride, data + i * stride + cols,
+                (*matrix)[i].begin());
+    return std::shared_ptr<const T>(matrix, matrix->data());
+  }
+};
+
+}  // namespace Problem
+}  // namespace DE
+#endif  // DE_CEC_DATA_REGISTRY_HPP
@@ -15,6 +15,7 @@
 #include <cstdio>
 #include <stdexcept>
 #include <algorithm>
+#include <memory>
 #include "problem/simple_problem.hpp"
 #include "problem/cec_basic_problem.hpp"
 
@@ -34,10 +35,6 @@ class CECHybrid : public CECFunction<T> {
             const char* shuffle_file = nullptr,
             const std::size_t shuffle_offset = 0)
       : CECFunction<T>(D, name), percentage_(percentage) {
-    // Constrains
-    for (std::size_t i = 0; i < Base<T>::D_; ++i)
-      SimpleFitnessFunction<T>::constrains_.insert(
-          std::make_pair(i, Constrain<double>(-100, 100)));
     // Populate genes_
     genes_.resize(percentage_.size(), 0);
     for (std::size_t i = 0; i < percentage_.size() - 1; ++i)
@@ -47,29 +44,69 @@ class CECHybrid : public CECFunction<T> {
     parse_shuffle_data(shuffle_file, shuffle_offset);
   };
 
-  double evaluate(const std::vector<T>& chromosome) const {
+  double evaluate(ConstRowView<T> chromosome) const {
     assert(chromosome.size() == Base<T>::D_);
-    thread_local std::vector<std::vector<T>> partials;
-    partials.resize(percentage_.size());
-    for (std::size_t i = 0; i < percentage_.size(); ++i)
-      partials[i].resize(genes_[i]);
+    assert(gene_scales_.size() == Base<T>::D_);
+    ScratchVector<T> permuted(Base<T>::D_);
+    for (std::size_t j = 0; j < Base<T>::D_; ++j)
+      permuted[j] = chromosome[order_[j]] * gene_scales_[j];
     double sum = 0.0;
-    std::size_t start = 0;
-    for (std::size_t i = 0; i < percentage_.size(); ++i) {
-      start += (i == 0 ? 0 : genes_[i - 1]);
-      const std::size_t end =
-          (i == percentage_.size() ? Base<T>::D_ : start + genes_[i]);
-      for (std::size_t j = start; j < end; ++j) {
-        partials[i][j - start] = chromosome[shuffle_[j] - 1];
-      }
-      sum += functions_[i]->fitness(partials[i]);
+    for (std::size_t i = 0, start = 0; i < functions_.size();
+         start += genes_[i++]) {
+      ConstRowView<T> genes(permuted.data() + start, genes_[i]);
+      sum += direct_[i] ? functions_[i]->evaluate(genes)
+                        : functions_[i]->fitness(genes);
     }
     return sum;
   }
 
+  /*!
+   * \brief Evaluate the hybrid function on a block of chromosomes
+   *
+   * In chunks of batch_rows_ chromosomes, the genes of every chromosome are
+   * permuted (and scaled) into one block, whose columns belonging to each
+   * basic function the basic function evaluates at once.
+   *
+   * \param chromosomes : The chromosomes, one per row
+   * \param fitness     : Output, one value per row of \p chromosomes
+   */
+
+  void evaluate_batch(ConstBlockView<T> chromosomes, double* fitness) const {
+    assert(chromosomes.cols() == Base<T>::D_);
+    assert(gene_scales_.size() == Base<T>::D_);
+    const std::size_t D = Base<T>::D_, stride = Matrix<T>::padded_size(D);
+    const std::size_t rows = std::min(chromosomes.rows(), batch_rows_);
+    ScratchVector<T> permuted(rows * stride);
+    ScratchVector<double> partial_fitness(rows);
+    for (std::size_t first = 0; first < chromosomes.rows(); first += rows) {
+      const auto chunk =
+          chromosomes.slice(first, std::min(rows, chromosomes.rows() - first));
+      for (std::size_t r = 0; r < chunk.rows(); ++r) {
+        T* row = permuted.data() + r * stride;
+        for (std::size_t j = 0; j < D; ++j)
+          row[j] = chunk[r][order_[j]] * gene_scales_[j];
+      }
+      std::fill_n(fitness + first, chunk.rows(), 0.0);
+      for (std::size_t i = 0, start = 0; i < functions_.size();
+           start += genes_[i++]) {
+        ConstBlockView<T> genes(permuted.data() + start, chunk.rows(),
+                                genes_[i], stride);
+        if (direct_[i])
+          functions_[i]->evaluate_batch(genes, partial_fitness.data());
+        else
+          functions_[i]->fitness_batch(genes, partial_fitness.data());
+        for (std::size_t r = 0; r < chunk.rows(); ++r)
+          fitness[first + r] += partial_fitness[r];
+      }
+    }
+  }
+
   /*!
    * \brief Parse the shuffle file (shuffle_*.txt) generated by the .m file
    *
+   * The shuffle is loaded once per process and shared (\see
+   * CECDataRegistry).
+   *
    * \param shuffle_file   : Path to the .txt file
    * \param shuffle_offset : If specified, skip this many values
    *
@@ -78,34 +115,69 @@ class CECHybrid : public CECFunction<T> {
 
   void parse_shuffle_data(const char* shuffle_file,
                           std::size_t shuffle_offset = 0) {
-    shuffle_.resize(Base<T>::D_);
+    const std::size_t D = Base<T>::D_;
     if (shuffle_file) {
-      FILE* fpt = fopen(shuffle_file, "r");
-      if (fpt == NULL)
-        throw std::runtime_error("Unable to open shuffle file");
-      if (shuffle_offset > 0)
-        while (shuffle_offset-- != 0)
-          fscanf(fpt, "%lu", &shuffle_[0]);
-      for (std::size_t i = 0; i < Base<T>::D_; ++i)
-        fscanf(fpt, "%lu", &shuffle_[i]);
-      fclose(fpt);
+      shuffle_ = CECDataRegistry<T>::shuffle(shuffle_file, shuffle_offset, D);
     } else {
-      std::iota(shuffle_.begin(), shuffle_.end(), Base<T>::D_);
+      auto identity = std::make_shared<std::vector<std::size_t>>(D);
+      std::iota(identity->begin(), identity->end(), 1);
+      shuffle_ = identity;
+    }
+    order_.resize(D);
+    for (std::size_t i = 0; i < D; ++i) {
+      if ((*shuffle_)[i] < 1 || (*shuffle_)[i] > D)
+        throw std::runtime_error("Invalid shuffle data");
+      order_[i] = (*shuffle_)[i] - 1;
     }
   }
 
  protected:
   /*! The basic functions from which the hybrid function is comprised */
-  std::vector<CECFunction<double>*> functions_;
+  std::vector<CECFunction<T>*> functions_;
   /*! The number of genes per function */
   std::vector<unsigned short int> genes_;
 
+  /*!
+   * \brief Gather what the basic functions need from the permuted genes
+   *
+   * Must be called once functions_ is set. Basic functions with neither
+   * shift nor rotation are evaluated directly on the permuted genes, which
+   * are scaled while they are gathered; the others through their fitness.
+   */
+
+  void build_tables() {
+    assert(functions_.size() == genes_.size());
+    gene_scales_.assign(Base<T>::D_, T(1));
+    direct_.assign(functions_.size(), false);
+    for (std::size_t i = 0, start = 0; i < functions_.size();
+         start += genes_[i++]) {
+      const auto& func = *functions_[i];
+      direct_[i] = func.get_shift_data().empty() &&
+                   func.get_rotation_data().empty() &&
+                   !func.transforms_internally();
+      if (direct_[i])
+        std::fill_n(gene_scales_.begin() + start, genes_[i],
+                    func.get_scale_factor());
+    }
+  }
+
  private:
+  /*! Number of chromosomes permuted at once by evaluate_batch */
+  static constexpr std::size_t batch_rows_ = 64;
   /*! Percentage for each basic function */
   const std::vector<double> percentage_;
-  /*! Random shuffling for all the genes (size D) */
-  std::vector<std::size_t> shuffle_;
+  /*! Random shuffling for all the genes (size D), shared */
+  std::shared_ptr<const std::vector<std::size_t>> shuffle_;
+  /*! The shuffling from zero: gene j of the permuted chromosome */
+  std::vector<std::size_t> order_;
+  /*! Scale factor of every permuted gene */
+  std::vector<T> gene_scales_;
+  /*! True if the basic function is evaluated directly */
+  std::vector<bool> direct_;
 };
+
+template <class T>
+constexpr std::size_t CECHybrid<T>::batch_rows_;
 }  // namespace Problem
 }  // namespace DE
 #endif  // DE_CEC_HYBRID_PROBLEM_HPP
@@ -16,15 +16,16 @@ namespace Problem {
  * x_1^2 + \displaystyle 10^6 \sum_{i=2}^{n} x_i^2 \f$
  */
 
-class CigarFunction : public CECFunction<double> {
+template <class T>
+class CigarFunction : public CECFunction<T> {
  public:
   explicit CigarFunction(const std::size_t D)
-      : CECFunction(D, "Cigar Function") {}
+      : CECFunction<T>(D, "Cigar Function") {}
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
     double sum = chromosome[0] * chromosome[0];
-    for (std::size_t i = 1; i < D_; ++i)
+    for (std::size_t i = 1; i < this->D_; ++i)
       sum += 1000000 * chromosome[i] * chromosome[i];
     return sum;
   }
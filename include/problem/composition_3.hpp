@@ -15,24 +15,26 @@ namespace Problem {
  * \brief Composition function 3 of CEC-2017
  */
 
-class CompositionFunction3 : public CECComposition<double> {
+template <class T>
+class CompositionFunction3 : public CECComposition<T> {
  public:
   CompositionFunction3(const std::size_t D,
                        const char* shift_file = nullptr,
                        const char* rotation_file = nullptr)
-      : CECComposition<double>(D, "Composition Function 3") {
+      : CECComposition<T>(D, "Composition Function 3") {
     auto bias = std::vector<double>{0.0, 100.0, 200.0, 300.0};
-    functions_ = {BasicFunction(new RosenbrockFunction(D), 10, 1, bias[0]),
-                  BasicFunction(new AckleyFunction(D), 20, 10, bias[1]),
-                  BasicFunction(new SchwefelFunction(D), 30, 1, bias[2]),
-                  BasicFunction(new RastriginFunction(D), 40, 1, bias[3])};
+    this->functions_ = {{new RosenbrockFunction<T>(D), 10, 1, bias[0]},
+                  {new AckleyFunction<T>(D), 20, 10, bias[1]},
+                  {new SchwefelFunction<T>(D), 30, 1, bias[2]},
+                  {new RastriginFunction<T>(D), 40, 1, bias[3]}};
 
     if (shift_file)
-      for (std::size_t i = 0; i < functions_.size(); ++i)
-        functions_[i].func->parse_shift_file(shift_file, i);
+      for (std::size_t i = 0; i < this->functions_.size(); ++i)
+        this->functions_[i].func->parse_shift_file(shift_file, i);
     if (rotation_file)
-      for (std::size_t i = 0; i < functions_.size(); ++i)
-        functions_[i].func->parse_rotation_file(rotation_file, i * D);
+      for (std::size_t i = 0; i < this->functions_.size(); ++i)
+        this->functions_[i].func->parse_rotation_file(rotation_file, i * D);
+    this->build_tables();
   }
 };
 }  // namespace Problem
@@ -17,26 +17,28 @@ namespace Problem {
  * \brief Composition function 7 of CEC-2017
  */
 
-class CompositionFunction7 : public CECComposition<double> {
+template <class T>
+class CompositionFunction7 : public CECComposition<T> {
  public:
   CompositionFunction7(const std::size_t D,
                        const char* shift_file = nullptr,
                        const char* rotation_file = nullptr)
-      : CECComposition<double>(D, "Composition Function 7") {
+      : CECComposition<T>(D, "Composition Function 7") {
     auto bias = std::vector<double>{0.0, 100.0, 200.0, 300.0, 400.0, 500.0};
-    functions_ = {
-        BasicFunction(new HGBatFunction(D), 10, 10, bias[0]),
-        BasicFunction(new RastriginFunction(D), 20, 10, bias[1]),
-        BasicFunction(new SchwefelFunction(D), 30, 2.5, bias[2]),
-        BasicFunction(new CigarFunction(D), 40, 1e-26, bias[3]),
-        BasicFunction(new HighConditionedElliptic(D), 50, 1e-6, bias[4]),
-        BasicFunction(new SchafferFunction(D), 60, 5e-4, bias[5])};
+    this->functions_ = {
+        {new HGBatFunction<T>(D), 10, 10, bias[0]},
+        {new RastriginFunction<T>(D), 20, 10, bias[1]},
+        {new SchwefelFunction<T>(D), 30, 2.5, bias[2]},
+        {new CigarFunction<T>(D), 40, 1e-26, bias[3]},
+        {new HighConditionedElliptic<T>(D), 50, 1e-6, bias[4]},
+        {new SchafferFunction<T>(D), 60, 5e-4, bias[5]}};
     if (shift_file)
-      for (std::size_t i = 0; i < functions_.size(); ++i)
-        functions_[i].func->parse_shift_file(shift_file, i);
+      for (std::size_t i = 0; i < this->functions_.size(); ++i)
+        this->functions_[i].func->parse_shift_file(shift_file, i);
     if (rotation_file)
-      for (std::size_t i = 0; i < functions_.size(); ++i)
-        functions_[i].func->parse_rotation_file(rotation_file, i * D);
+      for (std::size_t i = 0; i < this->functions_.size(); ++i)
+        this->functions_[i].func->parse_rotation_file(rotation_file, i * D);
+    this->build_tables();
   }
 };
 }  // namespace Problem
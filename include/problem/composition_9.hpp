@@ -14,25 +14,27 @@ namespace Problem {
  * \brief Composition function 9 of CEC-2017
  */
 
-class CompositionFunction9 : public CECComposition<double> {
+template <class T>
+class CompositionFunction9 : public CECComposition<T> {
  public:
   CompositionFunction9(const std::size_t D,
                        const char* shift_file = nullptr,
                        const char* rotation_file = nullptr,
                        const char* shuffle_file = nullptr)
-      : CECComposition<double>(D, "Composition Function 9") {
+      : CECComposition<T>(D, "Composition Function 9") {
     auto bias = std::vector<double>{0.0, 100.0, 200.0};
-    functions_ = {
-        BasicFunction(new HybridFunction5(D, shuffle_file), 10, 1, bias[0]),
-        BasicFunction(new HybridFunction6(D, shuffle_file, D), 30, 1, bias[1]),
-        BasicFunction(new HybridFunction7(D, shuffle_file, 2 * D), 50, 1,
-                      bias[2])};
+    this->functions_ = {
+        {new HybridFunction5<T>(D, shuffle_file), 10, 1, bias[0]},
+        {new HybridFunction6<T>(D, shuffle_file, D), 30, 1, bias[1]},
+        {new HybridFunction7<T>(D, shuffle_file, 2 * D), 50, 1,
+         bias[2]}};
     if (shift_file)
-      for (std::size_t i = 0; i < functions_.size(); ++i)
-        functions_[i].func->parse_shift_file(shift_file, i);
+      for (std::size_t i = 0; i < this->functions_.size(); ++i)
+        this->functions_[i].func->parse_shift_file(shift_file, i);
     if (rotation_file)
-      for (std::size_t i = 0; i < functions_.size(); ++i)
-        functions_[i].func->parse_rotation_file(rotation_file, i * D);
+      for (std::size_t i = 0; i < this->functions_.size(); ++i)
+        this->functions_[i].func->parse_rotation_file(rotation_file, i * D);
+    this->build_tables();
   }
 };
 }  // namespace Problem
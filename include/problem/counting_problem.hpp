@@ -0,0 +1,87 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief A problem that counts the evaluations of another
+ */
+
+#ifndef DE_COUNTING_PROBLEM_HPP
+#define DE_COUNTING_PROBLEM_HPP
+
+#include <atomic>
+#include <memory>
+#include "problem/base_problem.hpp"
+
+namespace DE {
+namespace Problem {
+
+/*! \class CountingProblem
+ *  \brief Forwards everything to a problem and counts its evaluations
+ *
+ *  The count may be read while the problem is evaluated from several
+ *  threads. It is added to once per call, for a whole batch in
+ *  fitness_batch, so that the threads of an executor rarely meet on it.
+ */
+
+template <class T>
+class CountingProblem : public Base<T> {
+ public:
+  /*!
+   * \brief Count the evaluations of \p problem
+   *
+   * \param problem : The problem to be counted
+   */
+
+  explicit CountingProblem(std::shared_ptr<Base<T>> problem)
+      : Base<T>(problem->get_number_of_genes()), problem_(std::move(problem)) {}
+
+  void randomize(RowView<T> chromosome) const {
+    problem_->randomize(chromosome);
+  }
+
+  void constrain(RowView<T> chromosome) const {
+    problem_->constrain(chromosome);
+  }
+
+  void constrain_trial(RowView<T> trial, ConstRowView<T> parent) const {
+    problem_->constrain_trial(trial, parent);
+  }
+
+  void randomize_batch(BlockView<T> chromosomes) const {
+    problem_->randomize_batch(chromosomes);
+  }
+
+  void constrain_batch(BlockView<T> trials, ConstBlockView<T> parents) const {
+    problem_->constrain_batch(trials, parents);
+  }
+
+  double fitness(ConstRowView<T> chromosome) const {
+    evaluations_.fetch_add(1, std::memory_order_relaxed);
+    return problem_->fitness(chromosome);
+  }
+
+  void fitness_batch(ConstBlockView<T> chromosomes, double* fitness) const {
+    evaluations_.fetch_add(chromosomes.rows(), std::memory_order_relaxed);
+    problem_->fitness_batch(chromosomes, fitness);
+  }
+
+  /*! Number of chromosomes evaluated so far */
+  std::size_t get_evaluations() const {
+    return evaluations_.load(std::memory_order_relaxed);
+  }
+
+  /*! Start counting anew */
+  void reset() { evaluations_.store(0, std::memory_order_relaxed); }
+
+  /*! The problem counted */
+  const Base<T>& get_problem() const { return *problem_; }
+
+ private:
+  const std::shared_ptr<Base<T>> problem_; /*!< The problem counted */
+  mutable std::atomic<std::size_t> evaluations_{0};
+};
+
+}  // namespace Problem
+}  // namespace DE
+#endif  // DE_COUNTING_PROBLEM_HPP
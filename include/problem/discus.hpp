@@ -18,15 +18,16 @@ namespace Problem {
  * \f$
  */
 
-class DiscusFunction : public CECFunction<double> {
+template <class T>
+class DiscusFunction : public CECFunction<T> {
  public:
   explicit DiscusFunction(const std::size_t D)
-      : CECFunction(D, "Discus Function") {}
+      : CECFunction<T>(D, "Discus Function") {}
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
     double sum = 1000000 * chromosome[0] * chromosome[0];
-    for (std::size_t i = 1; i < D_; ++i)
+    for (std::size_t i = 1; i < this->D_; ++i)
       sum += chromosome[i] * chromosome[i];
     return sum;
   }
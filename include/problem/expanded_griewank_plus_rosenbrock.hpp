@@ -4,6 +4,7 @@
 #include <cmath>
 #include <assert.h>
 #include "problem/cec_basic_problem.hpp"
+#include "simd.hpp"
 
 namespace DE {
 namespace Problem {
@@ -22,17 +23,22 @@ namespace Problem {
  * \f$
  */
 
-class ExpandedGriewankPlusRosenbrock : public CECFunction<double> {
+template <class T>
+class ExpandedGriewankPlusRosenbrock : public CECFunction<T> {
  public:
   explicit ExpandedGriewankPlusRosenbrock(const std::size_t D)
-      : CECFunction(D, "Expanded Griewank's plus Rosenbrokc's Function") {
-    scale_ = 5.0 / 100.0;
+      : CECFunction<T>(D, "Expanded Griewank's plus Rosenbrokc's Function") {
+    this->scale_ = 5.0 / 100.0;
   }
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
+    if (SIMD::enabled()) {
+      const detail::DoubleGenes<T> x(chromosome);
+      return SIMD::kernels().griewank_rosenbrock(x.data(), this->D_);
+    }
     double rosenbrock_first_sum = 0.0, rosenbrock_output = 0.0, sum = 0.0;
-    for (std::size_t i = 0; i < D_ - 1; ++i) {
+    for (std::size_t i = 0; i < this->D_ - 1; ++i) {
       rosenbrock_first_sum =
           (chromosome[i] + 1) * (chromosome[i] + 1) - (chromosome[i + 1] + 1);
       rosenbrock_output = 100.0 * rosenbrock_first_sum * rosenbrock_first_sum +
@@ -40,10 +46,11 @@ class ExpandedGriewankPlusRosenbrock : public CECFunction<double> {
       sum += (rosenbrock_output * rosenbrock_output) / 4000.0 -
              cos(rosenbrock_output) + 1.0;
     }
-    rosenbrock_first_sum = (chromosome[D_ - 1] + 1) * (chromosome[D_ - 1] + 1) -
-                           (chromosome[0] + 1);
+    rosenbrock_first_sum =
+        (chromosome[this->D_ - 1] + 1) * (chromosome[this->D_ - 1] + 1) -
+        (chromosome[0] + 1);
     rosenbrock_output = 100.0 * rosenbrock_first_sum * rosenbrock_first_sum +
-                        chromosome[D_ - 1] * chromosome[D_ - 1];
+                        chromosome[this->D_ - 1] * chromosome[this->D_ - 1];
     sum += (rosenbrock_output * rosenbrock_output) / 4000.0 -
            cos(rosenbrock_output) + 1.0;
     return sum;
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <assert.h>
 #include "problem/cec_basic_problem.hpp"
+#include "simd.hpp"
 
 namespace DE {
 namespace Problem {
@@ -19,17 +20,22 @@ namespace Problem {
  * \f$
  */
 
-class GriewankFunction : public CECFunction<double> {
+template <class T>
+class GriewankFunction : public CECFunction<T> {
  public:
   explicit GriewankFunction(const std::size_t D)
-      : CECFunction(D, "Griewank's Function") {
-    scale_ = 600.0 / 100.0;
+      : CECFunction<T>(D, "Griewank's Function") {
+    this->scale_ = 600.0 / 100.0;
   }
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
+    if (SIMD::enabled()) {
+      const detail::DoubleGenes<T> x(chromosome);
+      return SIMD::kernels().griewank(x.data(), this->D_);
+    }
     double sum = 0.0, product = 1.0;
-    for (std::size_t i = 0; i < D_; ++i) {
+    for (std::size_t i = 0; i < this->D_; ++i) {
       sum += chromosome[i] * chromosome[i];
       product *= cos(chromosome[i] / sqrt(i + 1));
     }
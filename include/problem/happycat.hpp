@@ -19,24 +19,25 @@ namespace Problem {
  * \f$
  */
 
-class HappyCatFunction : public CECFunction<double> {
+template <class T>
+class HappyCatFunction : public CECFunction<T> {
  public:
   explicit HappyCatFunction(const std::size_t D)
-      : CECFunction(D, "HappyCat Function") {
-    scale_ = 5.0 / 100.0;
+      : CECFunction<T>(D, "HappyCat Function") {
+    this->scale_ = 5.0 / 100.0;
   }
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
     /* original global optimum: [-1,-1,...,-1] */
     double squared_sum = 0.0, gene_sum = 0.0;
     constexpr double alpha = 1.0 / 8.0;
-    for (std::size_t i = 0; i < D_; ++i) {
+    for (std::size_t i = 0; i < this->D_; ++i) {
       squared_sum += (chromosome[i] - 1.0) * (chromosome[i] - 1.0);
       gene_sum += chromosome[i] - 1.0;
     }
-    return pow(fabs(squared_sum - D_), 2 * alpha) +
-           (0.5 * squared_sum + gene_sum) / D_ + 0.5;
+    return pow(fabs(squared_sum - this->D_), 2 * alpha) +
+           (0.5 * squared_sum + gene_sum) / this->D_ + 0.5;
   }
 };
 }  // namespace Problem
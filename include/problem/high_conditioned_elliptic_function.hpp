@@ -18,16 +18,17 @@ namespace Problem {
  * \f$
  */
 
-class HighConditionedElliptic : public CECFunction<double> {
+template <class T>
+class HighConditionedElliptic : public CECFunction<T> {
  public:
   explicit HighConditionedElliptic(const std::size_t D)
-      : CECFunction(D, "High Conditioned Elliptic Function") {}
+      : CECFunction<T>(D, "High Conditioned Elliptic Function") {}
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
     double sum = 0.0;
-    for (std::size_t i = 0; i < D_; ++i)
-      sum += pow(10, 6.0 * i / (D_ - 1)) * chromosome[i] * chromosome[i];
+    for (std::size_t i = 0; i < this->D_; ++i)
+      sum += pow(10, 6.0 * i / (this->D_ - 1)) * chromosome[i] * chromosome[i];
     return sum;
   }
 };
@@ -14,19 +14,22 @@ namespace Problem {
  * \brief Hybrid function 1
  */
 
-class HybridFunction1 : public CECHybrid<double> {
+template <class T>
+class HybridFunction1 : public CECHybrid<T> {
  public:
   HybridFunction1(const std::size_t D,
                   const char* shuffle_file = nullptr,
                   const std::size_t shuffle_offset = 0)
-      : CECHybrid<double>(D,
-                          "Hybrid Function 1",
-                          {0.2, 0.4, 0.4},
-                          shuffle_file,
-                          shuffle_offset) {
-    functions_ = {new ZakharovFunction(genes_[0]),
-                  new RosenbrockFunction(genes_[1]),
-                  new RastriginFunction(genes_[2])};
+      : CECHybrid<T>(D,
+                     "Hybrid Function 1",
+                     {0.2, 0.4, 0.4},
+                     shuffle_file,
+                     shuffle_offset) {
+    const auto& genes = this->genes_;
+    this->functions_ = {new ZakharovFunction<T>(genes[0]),
+                        new RosenbrockFunction<T>(genes[1]),
+                        new RastriginFunction<T>(genes[2])};
+    this->build_tables();
   }
 };
 }  // namespace Problem
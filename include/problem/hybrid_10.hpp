@@ -17,20 +17,25 @@ namespace Problem {
  * \brief Hybrid function 10
  */
 
-class HybridFunction10 : public CECHybrid<double> {
+template <class T>
+class HybridFunction10 : public CECHybrid<T> {
  public:
   HybridFunction10(const std::size_t D,
                    const char* shuffle_file = nullptr,
                    const std::size_t shuffle_offset = 0)
-      : CECHybrid<double>(D,
-                          "Hybrid Function 10",
-                          {0.1, 0.1, 0.2, 0.2, 0.2, 0.2},
-                          shuffle_file,
-                          shuffle_offset) {
-    functions_ = {
-        new HGBatFunction(genes_[0]),    new KatsuuraFunction(genes_[1]),
-        new AckleyFunction(genes_[2]),   new RastriginFunction(genes_[3]),
-        new SchwefelFunction(genes_[4]), new SchafferF7Function(genes_[5])};
+      : CECHybrid<T>(D,
+                     "Hybrid Function 10",
+                     {0.1, 0.1, 0.2, 0.2, 0.2, 0.2},
+                     shuffle_file,
+                     shuffle_offset) {
+    const auto& genes = this->genes_;
+    this->functions_ = {new HGBatFunction<T>(genes[0]),
+                        new KatsuuraFunction<T>(genes[1]),
+                        new AckleyFunction<T>(genes[2]),
+                        new RastriginFunction<T>(genes[3]),
+                        new SchwefelFunction<T>(genes[4]),
+                        new SchafferF7Function<T>(genes[5])};
+    this->build_tables();
   }
 };
 }  // namespace Problem
@@ -14,19 +14,22 @@ namespace Problem {
  * \brief Hybrid function 2
  */
 
-class HybridFunction2 : public CECHybrid<double> {
+template <class T>
+class HybridFunction2 : public CECHybrid<T> {
  public:
   HybridFunction2(const std::size_t D,
                   const char* shuffle_file = nullptr,
                   const std::size_t shuffle_offset = 0)
-      : CECHybrid<double>(D,
-                          "Hybrid Function 2",
-                          {0.3, 0.3, 0.4},
-                          shuffle_file,
-                          shuffle_offset) {
-    functions_ = {new HighConditionedElliptic(genes_[0]),
-                  new SchwefelFunction(genes_[1]),
-                  new CigarFunction(genes_[2])};
+      : CECHybrid<T>(D,
+                     "Hybrid Function 2",
+                     {0.3, 0.3, 0.4},
+                     shuffle_file,
+                     shuffle_offset) {
+    const auto& genes = this->genes_;
+    this->functions_ = {new HighConditionedElliptic<T>(genes[0]),
+                        new SchwefelFunction<T>(genes[1]),
+                        new CigarFunction<T>(genes[2])};
+    this->build_tables();
   }
 };
 }  // namespace Problem
@@ -14,19 +14,22 @@ namespace Problem {
  * \brief Hybrid function 3
  */
 
-class HybridFunction3 : public CECHybrid<double> {
+template <class T>
+class HybridFunction3 : public CECHybrid<T> {
  public:
   HybridFunction3(const std::size_t D,
                   const char* shuffle_file = nullptr,
                   const std::size_t shuffle_offset = 0)
-      : CECHybrid<double>(D,
-                          "Hybrid Function 3",
-                          {0.3, 0.3, 0.4},
-                          shuffle_file,
-                          shuffle_offset) {
-    functions_ = {new CigarFunction(genes_[0]),
-                  new RosenbrockFunction(genes_[1]),
-                  new LunacekBiRastriginFunction(genes_[2], false)};
+      : CECHybrid<T>(D,
+                     "Hybrid Function 3",
+                     {0.3, 0.3, 0.4},
+                     shuffle_file,
+                     shuffle_offset) {
+    const auto& genes = this->genes_;
+    this->functions_ = {new CigarFunction<T>(genes[0]),
+                        new RosenbrockFunction<T>(genes[1]),
+                        new LunacekBiRastriginFunction<T>(genes[2], false)};
+    this->build_tables();
   }
 };
 }  // namespace Problem
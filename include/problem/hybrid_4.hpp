@@ -15,19 +15,23 @@ namespace Problem {
  * \brief Hybrid function 4
  */
 
-class HybridFunction4 : public CECHybrid<double> {
+template <class T>
+class HybridFunction4 : public CECHybrid<T> {
  public:
   HybridFunction4(const std::size_t D,
                   const char* shuffle_file = nullptr,
                   const std::size_t shuffle_offset = 0)
-      : CECHybrid<double>(D,
-                          "Hybrid Function 4",
-                          {0.2, 0.2, 0.2, 0.4},
-                          shuffle_file,
-                          shuffle_offset) {
-    functions_ = {
-        new HighConditionedElliptic(genes_[0]), new AckleyFunction(genes_[1]),
-        new SchafferF7Function(genes_[2]), new RastriginFunction(genes_[3])};
+      : CECHybrid<T>(D,
+                     "Hybrid Function 4",
+                     {0.2, 0.2, 0.2, 0.4},
+                     shuffle_file,
+                     shuffle_offset) {
+    const auto& genes = this->genes_;
+    this->functions_ = {new HighConditionedElliptic<T>(genes[0]),
+                        new AckleyFunction<T>(genes[1]),
+                        new SchafferF7Function<T>(genes[2]),
+                        new RastriginFunction<T>(genes[3])};
+    this->build_tables();
   }
 };
 }  // namespace Problem
@@ -15,19 +15,23 @@ namespace Problem {
  * \brief Hybrid function 5
  */
 
-class HybridFunction5 : public CECHybrid<double> {
+template <class T>
+class HybridFunction5 : public CECHybrid<T> {
  public:
   HybridFunction5(const std::size_t D,
                   const char* shuffle_file = nullptr,
                   const std::size_t shuffle_offset = 0)
-      : CECHybrid<double>(D,
-                          "Hybrid Function 5",
-                          {0.2, 0.2, 0.3, 0.3},
-                          shuffle_file,
-                          shuffle_offset) {
-    functions_ = {new CigarFunction(genes_[0]), new HGBatFunction(genes_[1]),
-                  new RastriginFunction(genes_[2]),
-                  new RosenbrockFunction(genes_[3])};
+      : CECHybrid<T>(D,
+                     "Hybrid Function 5",
+                     {0.2, 0.2, 0.3, 0.3},
+                     shuffle_file,
+                     shuffle_offset) {
+    const auto& genes = this->genes_;
+    this->functions_ = {new CigarFunction<T>(genes[0]),
+                        new HGBatFunction<T>(genes[1]),
+                        new RastriginFunction<T>(genes[2]),
+                        new RosenbrockFunction<T>(genes[3])};
+    this->build_tables();
   }
 };
 }  // namespace Problem
@@ -15,19 +15,23 @@ namespace Problem {
  * \brief Hybrid function 6
  */
 
-class HybridFunction6 : public CECHybrid<double> {
+template <class T>
+class HybridFunction6 : public CECHybrid<T> {
  public:
   HybridFunction6(const std::size_t D,
                   const char* shuffle_file = nullptr,
                   const std::size_t shuffle_offset = 0)
-      : CECHybrid<double>(D,
-                          "Hybrid Function 6",
-                          {0.2, 0.2, 0.3, 0.3},
-                          shuffle_file,
-                          shuffle_offset) {
-    functions_ = {new SchafferFunction(genes_[0]), new HGBatFunction(genes_[1]),
-                  new RosenbrockFunction(genes_[2]),
-                  new SchwefelFunction(genes_[3])};
+      : CECHybrid<T>(D,
+                     "Hybrid Function 6",
+                     {0.2, 0.2, 0.3, 0.3},
+                     shuffle_file,
+                     shuffle_offset) {
+    const auto& genes = this->genes_;
+    this->functions_ = {new SchafferFunction<T>(genes[0]),
+                        new HGBatFunction<T>(genes[1]),
+                        new RosenbrockFunction<T>(genes[2]),
+                        new SchwefelFunction<T>(genes[3])};
+    this->build_tables();
   }
 };
 }  // namespace Problem
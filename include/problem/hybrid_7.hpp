@@ -16,20 +16,24 @@ namespace Problem {
  * \brief Hybrid function 7
  */
 
-class HybridFunction7 : public CECHybrid<double> {
+template <class T>
+class HybridFunction7 : public CECHybrid<T> {
  public:
   HybridFunction7(const std::size_t D,
                   const char* shuffle_file = nullptr,
                   const std::size_t shuffle_offset = 0)
-      : CECHybrid<double>(D,
-                          "Hybrid Function 7",
-                          {0.1, 0.2, 0.2, 0.2, 0.3},
-                          shuffle_file,
-                          shuffle_offset) {
-    functions_ = {
-        new KatsuuraFunction(genes_[0]), new AckleyFunction(genes_[1]),
-        new ExpandedGriewankPlusRosenbrock(genes_[2]),
-        new SchwefelFunction(genes_[3]), new RastriginFunction(genes_[4])};
+      : CECHybrid<T>(D,
+                     "Hybrid Function 7",
+                     {0.1, 0.2, 0.2, 0.2, 0.3},
+                     shuffle_file,
+                     shuffle_offset) {
+    const auto& genes = this->genes_;
+    this->functions_ = {new KatsuuraFunction<T>(genes[0]),
+                        new AckleyFunction<T>(genes[1]),
+                        new ExpandedGriewankPlusRosenbrock<T>(genes[2]),
+                        new SchwefelFunction<T>(genes[3]),
+                        new RastriginFunction<T>(genes[4])};
+    this->build_tables();
   }
 };
 }  // namespace Problem
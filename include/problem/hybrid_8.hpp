@@ -16,20 +16,24 @@ namespace Problem {
  * \brief Hybrid function 8
  */
 
-class HybridFunction8 : public CECHybrid<double> {
+template <class T>
+class HybridFunction8 : public CECHybrid<T> {
  public:
   HybridFunction8(const std::size_t D,
                   const char* shuffle_file = nullptr,
                   const std::size_t shuffle_offset = 0)
-      : CECHybrid<double>(D,
-                          "Hybrid Function 8",
-                          {0.2, 0.2, 0.2, 0.2, 0.2},
-                          shuffle_file,
-                          shuffle_offset) {
-    functions_ = {new HighConditionedElliptic(genes_[0]),
-                  new AckleyFunction(genes_[1]),
-                  new RastriginFunction(genes_[2]),
-                  new HGBatFunction(genes_[3]), new DiscusFunction(genes_[4])};
+      : CECHybrid<T>(D,
+                     "Hybrid Function 8",
+                     {0.2, 0.2, 0.2, 0.2, 0.2},
+                     shuffle_file,
+                     shuffle_offset) {
+    const auto& genes = this->genes_;
+    this->functions_ = {new HighConditionedElliptic<T>(genes[0]),
+                        new AckleyFunction<T>(genes[1]),
+                        new RastriginFunction<T>(genes[2]),
+                        new HGBatFunction<T>(genes[3]),
+                        new DiscusFunction<T>(genes[4])};
+    this->build_tables();
   }
 };
 }  // namespace Problem
@@ -16,20 +16,24 @@ namespace Problem {
  * \brief Hybrid function 9
  */
 
-class HybridFunction9 : public CECHybrid<double> {
+template <class T>
+class HybridFunction9 : public CECHybrid<T> {
  public:
   HybridFunction9(const std::size_t D,
                   const char* shuffle_file = nullptr,
                   const std::size_t shuffle_offset = 0)
-      : CECHybrid<double>(D,
-                          "Hybrid Function 9",
-                          {0.2, 0.2, 0.2, 0.2, 0.2},
-                          shuffle_file,
-                          shuffle_offset) {
-    functions_ = {
-        new CigarFunction(genes_[0]), new RastriginFunction(genes_[1]),
-        new ExpandedGriewankPlusRosenbrock(genes_[2]),
-        new WeierstrassFunction(genes_[3]), new SchafferFunction(genes_[4])};
+      : CECHybrid<T>(D,
+                     "Hybrid Function 9",
+                     {0.2, 0.2, 0.2, 0.2, 0.2},
+                     shuffle_file,
+                     shuffle_offset) {
+    const auto& genes = this->genes_;
+    this->functions_ = {new CigarFunction<T>(genes[0]),
+                        new RastriginFunction<T>(genes[1]),
+                        new ExpandedGriewankPlusRosenbrock<T>(genes[2]),
+                        new WeierstrassFunction<T>(genes[3]),
+                        new SchafferFunction<T>(genes[4])};
+    this->build_tables();
   }
 };
 }  // namespace Problem
@@ -20,28 +20,44 @@ namespace Problem {
  * \f$
  */
 
-class KatsuuraFunction : public CECFunction<double> {
+template <class T>
+class KatsuuraFunction : public CECFunction<T> {
  public:
   explicit KatsuuraFunction(const std::size_t D)
-      : CECFunction(D, "Katsuura Function") {
-    scale_ = 5.0 / 100.0;
+      : CECFunction<T>(D, "Katsuura Function"),
+        exponent_(10.0 / pow(D, 1.2)),
+        factor_(10.0 / D / D) {
+    this->scale_ = 5.0 / 100.0;
+    // Powers of two, hence products and quotients by them are exact
+    double power_of_two = 1.0;
+    for (std::size_t j = 0; j < terms; ++j) {
+      power_of_two *= 2.0;
+      powers_[j] = power_of_two;
+      inverses_[j] = 1.0 / power_of_two;
+    }
   }
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
-    double product = 1.0, exponent = 10.0 / pow(D_, 1.2);
-    for (std::size_t i = 0; i < D_; ++i) {
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
+    double product = 1.0;
+    for (std::size_t i = 0; i < this->D_; ++i) {
       double sum = 0.0;
-      for (std::size_t j = 1; j <= 32; ++j) {
-        double power_of_two = pow(2.0, j),
-               inner_product = power_of_two * chromosome[i];
-        sum += fabs(inner_product - round(inner_product)) / power_of_two;
+      for (std::size_t j = 0; j < terms; ++j) {
+        const double inner_product = powers_[j] * chromosome[i];
+        sum += fabs(inner_product - round(inner_product)) * inverses_[j];
       }
-      product *= pow(1.0 + (i + 1) * sum, exponent);
+      product *= pow(1.0 + (i + 1) * sum, exponent_);
     }
-    double temp = 10.0 / D_ / D_;
-    return temp * product - temp;
+    return factor_ * product - factor_;
   }
+
+ private:
+  static constexpr std::size_t terms = 32;
+
+  const double exponent_; /*!< 10 / D^1.2 */
+  const double factor_;   /*!< 10 / D^2 */
+  double powers_[terms];  /*!< 2^j, j = 1, ..., 32 */
+  double inverses_[terms]; /*!< 2^-j */
 };
 }  // namespace Problem
 }  // namespace DE
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <assert.h>
 #include "problem/cec_basic_problem.hpp"
+#include "simd.hpp"
 
 namespace DE {
 namespace Problem {
@@ -20,24 +21,29 @@ namespace Problem {
  * (w_D-1)^2 (1 + \sin^2(2\pi w_D)) \f$
  */
 
-class LevyFunction : public CECFunction<double> {
+template <class T>
+class LevyFunction : public CECFunction<T> {
  public:
   explicit LevyFunction(const std::size_t D)
-      : CECFunction(D, "Levy Function") {}
-
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
-    std::vector<double> w(D_, 0.0);
-    for (size_t i = 0; i < D_; ++i)
-      w[i] = 1.0 + (chromosome[i] - 1.0) / 4.0;
-
-    double term1 = pow((sin(M_PI * w[0])), 2),
-           term3 = pow((w[D_ - 1] - 1), 2) *
-                   (1 + pow((sin(2 * M_PI * w[D_ - 1])), 2)),
+      : CECFunction<T>(D, "Levy Function") {}
+
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
+    if (SIMD::enabled()) {
+      const detail::DoubleGenes<T> x(chromosome);
+      return SIMD::kernels().levy(x.data(), this->D_);
+    }
+    const auto w = [&chromosome](const std::size_t i) {
+      return 1.0 + (chromosome[i] - 1.0) / 4.0;
+    };
+
+    double term1 = pow((sin(M_PI * w(0))), 2),
+           term3 = pow((w(this->D_ - 1) - 1), 2) *
+                   (1 + pow((sin(2 * M_PI * w(this->D_ - 1))), 2)),
            sum = 0.0;
 
-    for (size_t i = 0; i < D_ - 1; ++i)
-      sum += pow((w[i] - 1), 2) * (1 + 10 * pow((sin(M_PI * w[i] + 1)), 2));
+    for (size_t i = 0; i < this->D_ - 1; ++i)
+      sum += pow((w(i) - 1), 2) * (1 + 10 * pow((sin(M_PI * w(i) + 1)), 2));
 
     return term1 + sum + term3;
   }
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <assert.h>
 #include "problem/cec_basic_problem.hpp"
+#include "simd.hpp"
 
 namespace DE {
 namespace Problem {
@@ -31,43 +32,58 @@ namespace Problem {
  * \f$
  */
 
-class LunacekBiRastriginFunction : public CECFunction<double> {
+template <class T>
+class LunacekBiRastriginFunction : public CECFunction<T> {
  public:
   LunacekBiRastriginFunction(const std::size_t D, const bool b = true)
-      : CECFunction(D, "Lunacek bi-Rastrigin Function") {
-    handle_shift_and_rotation_internally_ = b;
+      : CECFunction<T>(D, "Lunacek bi-Rastrigin Function"),
+        s_(1.0 - 1.0 / (2.0 * std::sqrt(D + 20.0) - 8.2)),
+        mu_1_(-std::sqrt((mu_0 * mu_0 - d) / s_)) {
+    this->handle_shift_and_rotation_internally_ = b;
   }
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
-    double mu_0 = 2.5, d = 1.0;
-    double s = 1.0 - 1.0 / (2.0 * pow(D_ + 20.0, 0.5) - 8.2);
-    double mu_1 = -pow((mu_0 * mu_0 - d) / s, 0.5);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
+    ScratchVector<T> shifted(this->D_), zeta(this->D_);
+    if (this->handle_shift_and_rotation_internally_)
+      this->shift(chromosome, shifted.view());
+    else
+      std::copy(chromosome.begin(), chromosome.end(), shifted.data());
 
-    std::vector<double> shifted =
-        handle_shift_and_rotation_internally_ ? shift(chromosome) : chromosome;
-
-    for (std::size_t i = 0; i < D_; ++i)
+    for (std::size_t i = 0; i < this->D_; ++i)
       shifted[i] =
           2 * (chromosome[i] < 0 ? -1.0 : 1.0) * 10.0 / 100.0 * shifted[i];
 
-    std::vector<double> zeta =
-        handle_shift_and_rotation_internally_ ? rotate(shifted) : shifted;
+    if (this->handle_shift_and_rotation_internally_)
+      this->rotate(shifted.view(), zeta.view());
+    else
+      std::copy(shifted.data(), shifted.data() + this->D_, zeta.data());
 
-    for (auto& gene : shifted)
-      gene += mu_0;
+    for (std::size_t i = 0; i < this->D_; ++i)
+      shifted[i] += mu_0;
 
     double sum_1 = 0.0, sum_2 = 0.0, sum_3 = 0.0;
-    for (std::size_t i = 0; i < D_; ++i) {
+    for (std::size_t i = 0; i < this->D_; ++i) {
       sum_1 += (shifted[i] - mu_0) * (shifted[i] - mu_0);
-      sum_2 += (shifted[i] - mu_1) * (shifted[i] - mu_1);
+      sum_2 += (shifted[i] - mu_1_) * (shifted[i] - mu_1_);
     }
 
-    for (std::size_t i = 0; i < D_; ++i)
-      sum_3 += cos(2.0 * M_PI * zeta[i]);
+    if (SIMD::enabled())
+      sum_3 = SIMD::kernels().sum_cos_2pi(
+          detail::DoubleGenes<T>(zeta.view()).data(), this->D_);
+    else
+      for (std::size_t i = 0; i < this->D_; ++i)
+        sum_3 += cos(2.0 * M_PI * zeta[i]);
 
-    return std::min(sum_1, d * D_ + s * sum_2) + 10 * (D_ - sum_3);
+    return std::min(sum_1, d * this->D_ + s_ * sum_2) +
+           10 * (this->D_ - sum_3);
   }
+
+ private:
+  static constexpr double mu_0 = 2.5, d = 1.0;
+
+  const double s_;    /*!< s of the definition, depends on D only */
+  const double mu_1_; /*!< mu_1 of the definition */
 };
 }  // namespace Problem
 }  // namespace DE
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <assert.h>
 #include "problem/cec_basic_problem.hpp"
+#include "simd.hpp"
 
 namespace DE {
 namespace Problem {
@@ -32,30 +33,35 @@ namespace Problem {
  * \f$
  */
 
-class SchwefelFunction : public CECFunction<double> {
+template <class T>
+class SchwefelFunction : public CECFunction<T> {
  public:
   explicit SchwefelFunction(const std::size_t D)
-      : CECFunction(D, "Schwefel's Function") {
-    scale_ = 1000.0 / 100.0;
+      : CECFunction<T>(D, "Schwefel's Function") {
+    this->scale_ = 1000.0 / 100.0;
   }
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
+    if (SIMD::enabled()) {
+      const detail::DoubleGenes<T> x(chromosome);
+      return SIMD::kernels().schwefel(x.data(), this->D_);
+    }
     double sum = 0;
-    for (std::size_t i = 0; i < D_; ++i) {
-      double z = 4.209687462275036e+002 + chromosome[i];
+    for (std::size_t i = 0; i < this->D_; ++i) {
+      const double z = 4.209687462275036e+002 + chromosome[i];
       if (z > 500) {
-        sum -= (500.0 - fmod(z, 500)) * sin(pow(500.0 - fmod(z, 500), 0.5)) -
-               pow((z - 500.0) / 100, 2) / D_;
+        const double folded = 500.0 - fmod(z, 500), excess = (z - 500.0) / 100;
+        sum -= folded * sin(std::sqrt(folded)) - excess * excess / this->D_;
       } else if (z < -500) {
-        sum -= (-500.0 + fmod(fabs(z), 500)) *
-                   sin(pow(500.0 - fmod(fabs(z), 500), 0.5)) -
-               pow((z + 500.0) / 100, 2) / D_;
+        const double folded = 500.0 - fmod(fabs(z), 500),
+                     excess = (z + 500.0) / 100;
+        sum -= -folded * sin(std::sqrt(folded)) - excess * excess / this->D_;
       } else {
-        sum -= z * sin(pow(fabs(z), 0.5));
+        sum -= z * sin(std::sqrt(fabs(z)));
       }
     }
-    sum += 4.189828872724338e+002 * D_;
+    sum += 4.189828872724338e+002 * this->D_;
     return sum;
   }
 };
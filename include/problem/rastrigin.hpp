@@ -4,6 +4,7 @@
 #include <cmath>
 #include <assert.h>
 #include "problem/cec_basic_problem.hpp"
+#include "simd.hpp"
 
 namespace DE {
 namespace Problem {
@@ -18,17 +19,22 @@ namespace Problem {
  * \f$
  */
 
-class RastriginFunction : public CECFunction<double> {
+template <class T>
+class RastriginFunction : public CECFunction<T> {
  public:
   explicit RastriginFunction(const std::size_t D)
-      : CECFunction(D, "Rastrigin's Function") {
-    scale_ = 5.12 / 100.0;
+      : CECFunction<T>(D, "Rastrigin's Function") {
+    this->scale_ = 5.12 / 100.0;
   }
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
+    if (SIMD::enabled()) {
+      const detail::DoubleGenes<T> x(chromosome);
+      return SIMD::kernels().rastrigin(x.data(), this->D_);
+    }
     double sum = 0.0;
-    for (std::size_t i = 0; i < D_; ++i)
+    for (std::size_t i = 0; i < this->D_; ++i)
       sum += chromosome[i] * chromosome[i] -
              10 * cos(2 * M_PI * chromosome[i]) + 10;
     return sum;
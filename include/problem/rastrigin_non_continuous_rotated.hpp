@@ -4,6 +4,7 @@
 #include <cmath>
 #include <assert.h>
 #include "problem/cec_basic_problem.hpp"
+#include "simd.hpp"
 
 namespace DE {
 namespace Problem {
@@ -18,17 +19,22 @@ namespace Problem {
  * \f$
  */
 
-class RastriginNonContinuousRotatedFunction : public CECFunction<double> {
+template <class T>
+class RastriginNonContinuousRotatedFunction : public CECFunction<T> {
  public:
   explicit RastriginNonContinuousRotatedFunction(const std::size_t D)
-      : CECFunction(D, "Non-continuous Rotated Rastrigin's Function") {
-    scale_ = 5.12 / 100.0;
+      : CECFunction<T>(D, "Non-continuous Rotated Rastrigin's Function") {
+    this->scale_ = 5.12 / 100.0;
   }
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
+    if (SIMD::enabled()) {
+      const detail::DoubleGenes<T> x(chromosome);
+      return SIMD::kernels().rastrigin(x.data(), this->D_);
+    }
     double sum = 0.0;
-    for (std::size_t i = 0; i < D_; ++i)
+    for (std::size_t i = 0; i < this->D_; ++i)
       sum += (chromosome[i] * chromosome[i] -
               10.0 * cos(2.0 * M_PI * chromosome[i]) + 10.0);
     return sum;
@@ -18,17 +18,18 @@ namespace Problem {
  * \f$
  */
 
-class RosenbrockFunction : public CECFunction<double> {
+template <class T>
+class RosenbrockFunction : public CECFunction<T> {
  public:
   explicit RosenbrockFunction(const std::size_t D)
-      : CECFunction(D, "Rosenbrock's Function") {
-    scale_ = 2.048 / 100.0;
+      : CECFunction<T>(D, "Rosenbrock's Function") {
+    this->scale_ = 2.048 / 100.0;
   }
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
     double sum = 0.0;
-    for (std::size_t i = 0; i < D_ - 1; ++i)
+    for (std::size_t i = 0; i < this->D_ - 1; ++i)
       sum += 100 * pow((chromosome[i] + 1.0) * (chromosome[i] + 1.0) -
                            (chromosome[i + 1] + 1.0),
                        2) +
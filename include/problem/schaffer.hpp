@@ -27,15 +27,16 @@ namespace Problem {
  * \f$
  */
 
-class SchafferFunction : public CECFunction<double> {
+template <class T>
+class SchafferFunction : public CECFunction<T> {
  public:
   explicit SchafferFunction(const std::size_t D)
-      : CECFunction(D, "Schaffer's Function") {}
+      : CECFunction<T>(D, "Schaffer's Function") {}
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
     double sum = 0.0, temp_1 = 0.0, temp_2 = 0.0;
-    for (std::size_t i = 0; i < D_ - 1; ++i) {
+    for (std::size_t i = 0; i < this->D_ - 1; ++i) {
       temp_1 = sin(sqrt(chromosome[i] * chromosome[i] +
                         chromosome[i + 1] * chromosome[i + 1]));
       temp_1 = temp_1 * temp_1;
@@ -44,11 +45,11 @@ class SchafferFunction : public CECFunction<double> {
                         chromosome[i + 1] * chromosome[i + 1]);
       sum += 0.5 + (temp_1 - 0.5) / (temp_2 * temp_2);
     }
-    temp_1 = sin(sqrt(chromosome[D_ - 1] * chromosome[D_ - 1] +
+    temp_1 = sin(sqrt(chromosome[this->D_ - 1] * chromosome[this->D_ - 1] +
                       chromosome[0] * chromosome[0]));
     temp_1 = temp_1 * temp_1;
     temp_2 = 1.0 +
-             0.001 * (chromosome[D_ - 1] * chromosome[D_ - 1] +
+             0.001 * (chromosome[this->D_ - 1] * chromosome[this->D_ - 1] +
                       chromosome[0] * chromosome[0]);
     sum += 0.5 + (temp_1 - 0.5) / (temp_2 * temp_2);
     return sum;
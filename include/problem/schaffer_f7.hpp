@@ -20,22 +20,23 @@ namespace Problem {
  * \f$
  */
 
-class SchafferF7Function : public CECFunction<double> {
+template <class T>
+class SchafferF7Function : public CECFunction<T> {
  public:
   explicit SchafferF7Function(const std::size_t D)
-      : CECFunction(D, "Schaffer's F7 Function") {}
+      : CECFunction<T>(D, "Schaffer's F7 Function") {}
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
     double sum = 0.0;
-    for (std::size_t i = 0; i < D_ - 1; ++i) {
-      double s = pow(
-          chromosome[i] * chromosome[i] + chromosome[i + 1] * chromosome[i + 1],
-          0.5);
-      double tmp = sin(50.0 * pow(s, 0.2));
-      sum += pow(s, 0.5) + pow(s, 0.5) * tmp * tmp;
+    for (std::size_t i = 0; i < this->D_ - 1; ++i) {
+      const double x_i = chromosome[i], x_next = chromosome[i + 1];
+      const double s = std::sqrt(x_i * x_i + x_next * x_next);
+      const double root = std::sqrt(s);
+      const double tmp = sin(50.0 * pow(s, 0.2));
+      sum += root + root * tmp * tmp;
     }
-    return sum * sum / (D_ - 1) / (D_ - 1);
+    return sum * sum / (this->D_ - 1) / (this->D_ - 1);
   }
 };
 }  // namespace Problem
@@ -9,31 +9,177 @@
 #ifndef DE_SIMPLE_PROBLEM_HPP
 #define DE_SIMPLE_PROBLEM_HPP
 
-#include <map>
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <vector>
 #include "problem/base_problem.hpp"
 #include "rand.hpp"
+#include "simd.hpp"
 
 namespace DE {
 namespace Problem {
-/*! \struct Constrain
- *  \brief A simple struct containing a [lower, upper] constrain
+
+/*! \enum BoundHandling
+ *  \brief How a gene that left its bounds is brought back
  */
 
-template <typename T>
-struct Constrain {
- public:
-  T lower; /*!< Lower bound */
-  T upper; /*!< Upper bound */
-  Constrain(const T& l, const T& u) : lower(l), upper(u){};
+enum class BoundHandling {
+  random,   /*!< Drawn anew within the bounds */
+  clip,     /*!< Set to the bound it crossed */
+  reflect,  /*!< Mirrored on the bound it crossed (then clipped) */
+  midpoint  /*!< Midway between the bound it crossed and the parent's gene
+                 (SHADE); clipped if there is no parent */
 };
 
+namespace detail {
+
+/*!
+ * \brief True if some gene is NaN or outside its bounds
+ *
+ * \param x     : The genes
+ * \param lower : Lower bound of every gene
+ * \param upper : Upper bound of every gene
+ * \param D     : Number of genes
+ */
+
+template <class T>
+bool outside(const T* x, const T* lower, const T* upper, const std::size_t D) {
+  for (std::size_t i = 0; i < D; ++i)
+    if (!(lower[i] <= x[i] && x[i] <= upper[i]))
+      return true;
+  return false;
+}
+
+/*! On doubles, \see SIMD::Kernels */
+inline bool outside(const double* x, const double* lower, const double* upper,
+                    const std::size_t D) {
+  if (SIMD::enabled())
+    return SIMD::kernels().outside(x, lower, upper, D);
+  return outside<double>(x, lower, upper, D);
+}
+
+/*! On floats, \see SIMD::FloatKernels */
+inline bool outside(const float* x, const float* lower, const float* upper,
+                    const std::size_t D) {
+  if (SIMD::enabled())
+    return SIMD::float_kernels().outside(x, lower, upper, D);
+  return outside<float>(x, lower, upper, D);
+}
+
+/*!
+ * \brief Draw every gene uniformly within its bounds
+ *
+ * The genes are drawn in order, from the same numbers and with the same
+ * arithmetic as rand_uniform_real.
+ *
+ * \param x       : Output, the genes
+ * \param lower   : Lower bound of every gene
+ * \param upper   : Upper bound of every gene
+ * \param D       : Number of genes
+ * \param uniform : True if all the genes have the bounds of the first
+ */
+
+template <class T>
+void randomize(T* x, const T* lower, const T* upper, const std::size_t D,
+               const bool) {
+  ScratchVector<double> unit(D);
+  fill_uniform_real(unit.data(), D, 0.0, 1.0);
+  for (std::size_t i = 0; i < D; ++i)
+    x[i] = double(lower[i]) + unit[i] * (double(upper[i]) - double(lower[i]));
+}
+
+/*! On doubles, \see SIMD::Kernels */
+inline void randomize(double* x, const double* lower, const double* upper,
+                      const std::size_t D, const bool uniform) {
+  if (uniform) {
+    fill_uniform_real(x, D, lower[0], upper[0]);
+    return;
+  }
+  fill_uniform_real(x, D, 0.0, 1.0);
+  if (SIMD::enabled()) {
+    SIMD::kernels().scale_to_bounds(x, lower, upper, D);
+    return;
+  }
+  for (std::size_t i = 0; i < D; ++i)
+    x[i] = lower[i] + x[i] * (upper[i] - lower[i]);
+}
+
+/*!
+ * \brief Bring the genes outside their bounds back, by a deterministic policy
+ *
+ * \param policy : BoundHandling::clip, reflect or midpoint
+ * \param x      : The genes
+ * \param parent : The genes of the parent (midpoint only), or nullptr
+ * \param lower  : Lower bound of every gene
+ * \param upper  : Upper bound of every gene
+ * \param D      : Number of genes
+ */
+
+template <class T>
+void repair(const BoundHandling policy, T* x, const T* parent, const T* lower,
+            const T* upper, const std::size_t D) {
+  for (std::size_t i = 0; i < D; ++i) {
+    if (policy == BoundHandling::midpoint && parent) {
+      if (x[i] < lower[i])
+        x[i] = (lower[i] + parent[i]) / T(2);
+      else if (x[i] > upper[i])
+        x[i] = (upper[i] + parent[i]) / T(2);
+      continue;
+    }
+    if (policy == BoundHandling::reflect) {
+      if (x[i] < lower[i])
+        x[i] = T(2) * lower[i] - x[i];
+      else if (x[i] > upper[i])
+        x[i] = T(2) * upper[i] - x[i];
+    }
+    x[i] = std::max(lower[i], std::min(x[i], upper[i]));
+  }
+}
+
+/*! On doubles, \see SIMD::Kernels */
+inline void repair(const BoundHandling policy, double* x,
+                   const double* parent, const double* lower,
+                   const double* upper, const std::size_t D) {
+  if (!SIMD::enabled())
+    return repair<double>(policy, x, parent, lower, upper, D);
+  const auto& kernels = SIMD::kernels();
+  if (policy == BoundHandling::midpoint && parent)
+    kernels.midpoint(x, parent, lower, upper, D);
+  else if (policy == BoundHandling::reflect)
+    kernels.reflect(x, lower, upper, D);
+  else
+    kernels.clip(x, lower, upper, D);
+}
+
+/*! On floats, \see SIMD::FloatKernels */
+inline void repair(const BoundHandling policy, float* x, const float* parent,
+                   const float* lower, const float* upper,
+                   const std::size_t D) {
+  if (!SIMD::enabled())
+    return repair<float>(policy, x, parent, lower, upper, D);
+  const auto& kernels = SIMD::float_kernels();
+  if (policy == BoundHandling::midpoint && parent)
+    kernels.midpoint(x, parent, lower, upper, D);
+  else if (policy == BoundHandling::reflect)
+    kernels.reflect(x, lower, upper, D);
+  else
+    kernels.clip(x, lower, upper, D);
+}
+
+}  // namespace detail
+
 /*! \class SimpleFitnessFunction
  *  \brief A wrapper of Base for simple fitness functions
  *
  *  If you don't need to do explicit work inside your randomize and
- *  constrain functions inherit this class, and populate \p constrains_
- *  in your constructor. Then only implement the fitness function.
+ *  constrain functions inherit this class, and set the bounds of the genes
+ *  with set_bounds in your constructor. Then only implement the fitness
+ *  function.
+ *
+ *  The bounds are kept as two contiguous arrays, checked and repaired a
+ *  vector of genes at a time. Genes outside their bounds are brought back
+ *  as chosen by set_bound_handling; the default is BoundHandling::random.
  */
 
 template <class T>
@@ -47,14 +193,21 @@ class SimpleFitnessFunction : public Base<T> {
    */
 
   SimpleFitnessFunction(const std::size_t D, const char* name)
-      : Base<T>(D), name_(name){};
+      : Base<T>(D),
+        name_(name),
+        lower_(D, -std::numeric_limits<T>::infinity()),
+        upper_(D, std::numeric_limits<T>::infinity()){};
 
-  void randomize(std::vector<T>& chromosome) const {
+  void randomize(RowView<T> chromosome) const {
     assert(chromosome.size() == Base<T>::D_);
+    if (bounded_) {
+      detail::randomize(chromosome.data(), lower_.data(), upper_.data(),
+                        Base<T>::D_, uniform_);
+      return;
+    }
     for (std::size_t i = 0; i < Base<T>::D_; ++i) {
-      const auto& c = SimpleFitnessFunction<T>::constrains_.find(i);
-      if (c != SimpleFitnessFunction<T>::constrains_.end()) {  // exists
-        chromosome[i] = rand_uniform_real(c->second.lower, c->second.upper);
+      if (std::isfinite(lower_[i]) && std::isfinite(upper_[i])) {
+        chromosome[i] = rand_uniform_real(lower_[i], upper_[i]);
       } else {
         chromosome[i] = rand_uniform_real(std::numeric_limits<T>::min(),
                                           std::numeric_limits<T>::max());
@@ -62,18 +215,37 @@ class SimpleFitnessFunction : public Base<T> {
     }
   }
 
-  void constrain(std::vector<T>& chromosome) const {
+  void constrain(RowView<T> chromosome) const {
     assert(chromosome.size() == Base<T>::D_);
-    for (std::size_t i = 0; i < Base<T>::D_; ++i) {
-      const auto& c = SimpleFitnessFunction<T>::constrains_.find(i);
-      if (c != SimpleFitnessFunction<T>::constrains_.end()) {  // exists
-        chromosome[i] =
-            rand_within(chromosome[i], c->second.lower, c->second.upper);
-        // If you want to clip the values, \see clip
-      }
-    }
+    repair(chromosome.data(), nullptr);
+  }
+
+  void constrain_trial(RowView<T> trial, ConstRowView<T> parent) const {
+    assert(trial.size() == Base<T>::D_ && parent.size() == Base<T>::D_);
+    repair(trial.data(), parent.data());
+  }
+
+  /*!
+   * \brief Choose how genes that left their bounds are brought back
+   *
+   * \param policy : The policy
+   */
+
+  void set_bound_handling(const BoundHandling policy) {
+    bound_handling_ = policy;
   }
 
+  /*! The policy of constrain, \see set_bound_handling */
+  BoundHandling get_bound_handling() const { return bound_handling_; }
+
+  /*! The lower bound of every gene, -infinity if it has none at all
+   *  (\see set_bounds) */
+  const std::vector<T>& get_lower_bounds() const { return lower_; }
+
+  /*! The upper bound of every gene, infinity if it has none at all
+   *  (\see set_bounds) */
+  const std::vector<T>& get_upper_bounds() const { return upper_; }
+
   /*!
    * \brief Get the functions name
    *
@@ -84,23 +256,98 @@ class SimpleFitnessFunction : public Base<T> {
 
  protected:
   const char* name_; /*!< Name of the fitness function */
-  /*! Map indices (genes) to Constrain - if only one limit exists, replace
-   * the other one with std::numeric_limit<T>::min() or max() */
-  std::map<std::size_t, Constrain<T>> constrains_;
 
- private:
   /*!
-   * \brief Clip a \p value between [\p lower, \p upper]
+   * \brief Bound every gene to [\p lower, \p upper]
    *
-   * \param value : Input value
-   * \param lower : Left limit of the interval
-   * \param upper : Right limit of the interval
+   * \param lower : Lower bound
+   * \param upper : Upper bound
+   */
+
+  void set_bounds(T lower, T upper) {
+    assert(lower < upper);
+    replace_missing_limit(lower, upper);
+    std::fill(lower_.begin(), lower_.end(), lower);
+    std::fill(upper_.begin(), upper_.end(), upper);
+    update_bounds();
+  }
+
+  /*!
+   * \brief Bound a single gene to [\p lower, \p upper]
+   *
+   * If only one limit exists, pass an infinity for the other one. It is
+   * replaced with a limit numeric_limits<T>::max() / 2 away from the given
+   * one, so that the gene is drawn and repaired within a finite interval
+   * whose width does not overflow.
+   *
+   * \param gene  : Index of the gene
+   * \param lower : Lower bound
+   * \param upper : Upper bound
+   */
+
+  void set_bounds(const std::size_t gene, T lower, T upper) {
+    assert(gene < Base<T>::D_ && lower < upper);
+    replace_missing_limit(lower, upper);
+    lower_[gene] = lower;
+    upper_[gene] = upper;
+    update_bounds();
+  }
+
+ private:
+  std::vector<T> lower_; /*!< Lower bound of every gene */
+  std::vector<T> upper_; /*!< Upper bound of every gene */
+  /*! True if every gene has finite bounds */
+  bool bounded_ = false;
+  /*! True if, in addition, they are the same for every gene */
+  bool uniform_ = false;
+  BoundHandling bound_handling_ = BoundHandling::random;
+
+  /*! \brief Replace an infinite limit, if the other is finite
+   *         (\see set_bounds) */
+  static void replace_missing_limit(T& lower, T& upper) {
+    const T half = std::numeric_limits<T>::max() / 2;
+    if (std::isinf(lower) && std::isfinite(upper))
+      lower = std::max(std::numeric_limits<T>::lowest(), upper - half);
+    else if (std::isfinite(lower) && std::isinf(upper))
+      upper = std::min(std::numeric_limits<T>::max(), lower + half);
+  }
+
+  void update_bounds() {
+    bounded_ = std::all_of(lower_.begin(), lower_.end(),
+                           [](const T l) { return std::isfinite(l); }) &&
+               std::all_of(upper_.begin(), upper_.end(),
+                           [](const T u) { return std::isfinite(u); });
+    uniform_ = bounded_ &&
+               std::all_of(lower_.begin(), lower_.end(),
+                           [this](const T l) { return l == lower_[0]; }) &&
+               std::all_of(upper_.begin(), upper_.end(),
+                           [this](const T u) { return u == upper_[0]; });
+  }
+
+  /*!
+   * \brief Bring the genes outside their bounds back, \see BoundHandling
    *
-   * \return The new clipped value
+   * \param x      : The genes
+   * \param parent : The genes of the parent, or nullptr
    */
 
-  T clip(const T& value, const T& lower, const T& upper) const {
-    return std::max(lower, std::min(value, upper));
+  void repair(T* x, const T* parent) const {
+    const std::size_t D = Base<T>::D_;
+    if (!detail::outside(x, lower_.data(), upper_.data(), D))
+      return;
+    if (bound_handling_ != BoundHandling::random) {
+      detail::repair(bound_handling_, x, parent, lower_.data(), upper_.data(),
+                     D);
+      return;
+    }
+    // The genes draw in order, as each needs
+    if (uniform_) {
+      for (std::size_t i = 0; i < D; ++i)
+        x[i] = rand_within(x[i], lower_[0], upper_[0]);
+    } else {
+      for (std::size_t i = 0; i < D; ++i)
+        x[i] = rand_within(x[i], lower_[i], upper_[i]);
+    }
   }
 
   /*!
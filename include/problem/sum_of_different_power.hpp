@@ -18,15 +18,16 @@ namespace Problem {
  * \f$
  */
 
-class SumOfDifferentPowerFunction : public CECFunction<double> {
+template <class T>
+class SumOfDifferentPowerFunction : public CECFunction<T> {
  public:
   explicit SumOfDifferentPowerFunction(const std::size_t D)
-      : CECFunction(D, "Sum of different power Function") {}
+      : CECFunction<T>(D, "Sum of different power Function") {}
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
     double sum = 0.0;
-    for (std::size_t i = 0; i < D_; ++i)
+    for (std::size_t i = 0; i < this->D_; ++i)
       sum += pow((std::abs(chromosome[i])), (i + 1));
     return sum;
   }
@@ -20,29 +20,41 @@ namespace Problem {
  * \f$
  */
 
-class WeierstrassFunction : public CECFunction<double> {
+template <class T>
+class WeierstrassFunction : public CECFunction<T> {
  public:
   explicit WeierstrassFunction(const std::size_t D)
-      : CECFunction(D, "Weierstrass's Function") {
-    scale_ = 0.5 / 100.0;
+      : CECFunction<T>(D, "Weierstrass's Function") {
+    this->scale_ = 0.5 / 100.0;
+    // Exact powers, as pow computes them
+    double a_k = 1.0, b_k = 1.0;
+    for (std::size_t k = 0; k <= k_max; ++k, a_k *= a, b_k *= b) {
+      amplitudes_[k] = a_k;
+      frequencies_[k] = 2.0 * M_PI * b_k;
+      offset_ += amplitudes_[k] * cos(frequencies_[k] * 0.5);
+    }
   }
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
-    double sum_2 = 0.0, total = 0.0;
-    constexpr double a = 0.5, b = 3, k_max = 20;
-    for (std::size_t i = 0; i < D_; ++i) {
-      double sum_1 = 0.0;
-      sum_2 = 0.0;
-      for (std::size_t j = 0; j <= k_max; ++j) {
-        sum_1 +=
-            pow(a, j) * cos(2.0 * M_PI * pow(b, j) * (chromosome[i] + 0.5));
-        sum_2 += pow(a, j) * cos(2.0 * M_PI * pow(b, j) * 0.5);
-      }
-      total += sum_1;
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
+    double total = 0.0;
+    for (std::size_t i = 0; i < this->D_; ++i) {
+      const double y = chromosome[i] + 0.5;
+      double sum = 0.0;
+      for (std::size_t k = 0; k <= k_max; ++k)
+        sum += amplitudes_[k] * cos(frequencies_[k] * y);
+      total += sum;
     }
-    return total - D_ * sum_2;
+    return total - this->D_ * offset_;
   }
+
+ private:
+  static constexpr double a = 0.5, b = 3.0;
+  static constexpr std::size_t k_max = 20;
+
+  double amplitudes_[k_max + 1];  /*!< a^k */
+  double frequencies_[k_max + 1]; /*!< 2 pi b^k */
+  double offset_ = 0.0;           /*!< The sum of the terms at x_i = 0 */
 };
 }  // namespace Problem
 }  // namespace DE
@@ -19,15 +19,16 @@ namespace Problem {
  * \left( \sum_{i=1}^D 0.5 i x_i \right)^4 \f$
  */
 
-class ZakharovFunction : public CECFunction<double> {
+template <class T>
+class ZakharovFunction : public CECFunction<T> {
  public:
   explicit ZakharovFunction(const std::size_t D)
-      : CECFunction(D, "Zakharov Function") {}
+      : CECFunction<T>(D, "Zakharov Function") {}
 
-  double evaluate(const std::vector<double>& chromosome) const {
-    assert(chromosome.size() == D_);
+  double evaluate(ConstRowView<T> chromosome) const {
+    assert(chromosome.size() == this->D_);
     double sum_1 = 0.0, sum_2 = 0.0;
-    for (std::size_t i = 0; i < D_; ++i) {
+    for (std::size_t i = 0; i < this->D_; ++i) {
       sum_1 += pow(chromosome[i], 2);
       sum_2 += 0.5 * (i + 1) * chromosome[i];
     }
@@ -0,0 +1,319 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief Time spent by the algorithms in each of their phases
+ *
+ * The algorithms mark their phases with DE_PROFILE_PHASE, which times the
+ * rest of the enclosing scope. Unless DE_PROFILE_PHASES is defined when the
+ * algorithms are compiled, the macro expands to nothing and the phases cost
+ * nothing. Every thread adds its times to accumulators of its own, so that
+ * the phases run by the executor do not contend; PhaseProfiler::totals sums
+ * them over all the threads.
+ *
+ * A phase within another (the repair within the mutation, say) is not
+ * counted twice: the time of the inner phase is taken out of the outer one.
+ * With DE_PROFILE_TSC defined as well, the phases are timed with the time
+ * stamp counter (\see TscClock) where there is one.
+ *
+ * A ProfiledRun summarizes the phases of the runs from its construction on,
+ * as a table or as JSON.
+ */
+
+#ifndef DE_PROFILER_HPP
+#define DE_PROFILER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include "timer.hpp"
+
+namespace DE {
+
+/*! \enum Phase
+ *  \brief The phases of the algorithms that are timed
+ */
+
+enum class Phase {
+  top_p,           /*!< Sorting of the p best chromosomes (SHADE) */
+  mutation,        /*!< Mutation */
+  crossover,       /*!< Crossover */
+  archive,         /*!< Insertion into the archive (SHADE) */
+  memory_update,   /*!< Update of the memories of F and Cr (SHADE) */
+  size_reduction,  /*!< Linear population size reduction, with its sorting
+                        (L-SHADE) */
+  repair,          /*!< Repair of the mutants outside the bounds */
+  evaluation,      /*!< Evaluation of the fitness */
+  selection        /*!< Selection between the chromosomes and their trials */
+};
+
+/*! Number of Phase values */
+constexpr std::size_t number_of_phases = 9;
+
+/*! The name of a phase */
+inline const char* name(const Phase phase) {
+  static const char* const names[number_of_phases] = {
+      "update_top_p_solutions", "mutate",          "crossover",
+      "add_to_archive",         "memory_update",   "linear_size_reduction",
+      "constrain_trial",        "evaluate_trials", "select"};
+  return names[std::size_t(phase)];
+}
+
+/*! The timer of the phases */
+#if defined(DE_PROFILE_TSC) && defined(DE_HAS_TSC)
+using PhaseTimer = BasicTimer<TscClock>;
+#else
+using PhaseTimer = Timer;
+#endif
+
+/*!
+ * \class PhaseProfiler
+ * \brief The time spent in every phase, by all the threads
+ */
+
+class PhaseProfiler {
+ public:
+  /*! \brief Time and number of times of every phase, indexed by Phase */
+  struct Totals {
+    std::array<std::uint64_t, number_of_phases> nanoseconds{};
+    std::array<std::uint64_t, number_of_phases> calls{};
+  };
+
+  /*!
+   * \brief Add a timed run of a phase to the accumulators of this thread
+   *
+   * \param phase       : The phase
+   * \param nanoseconds : Time the phase took
+   */
+
+  static void add(const Phase phase, const std::uint64_t nanoseconds) {
+    auto& accumulator = local();
+    const std::size_t p = std::size_t(phase);
+    // Only this thread writes its accumulators
+    accumulator.nanoseconds[p].store(
+        accumulator.nanoseconds[p].load(std::memory_order_relaxed) +
+            nanoseconds,
+        std::memory_order_relaxed);
+    accumulator.calls[p].store(
+        accumulator.calls[p].load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+  }
+
+  /*! The sums over the threads, including those that have ended */
+  static Totals totals() {
+    Totals totals;
+    std::lock_guard<std::mutex> lock(mutex());
+    for (const auto& accumulator : accumulators())
+      for (std::size_t p = 0; p < number_of_phases; ++p) {
+        totals.nanoseconds[p] +=
+            accumulator->nanoseconds[p].load(std::memory_order_relaxed);
+        totals.calls[p] += accumulator->calls[p].load(std::memory_order_relaxed);
+      }
+    return totals;
+  }
+
+  /*! Zero the accumulators; call it while no phase runs */
+  static void reset() {
+    std::lock_guard<std::mutex> lock(mutex());
+    for (const auto& accumulator : accumulators())
+      for (std::size_t p = 0; p < number_of_phases; ++p) {
+        accumulator->nanoseconds[p].store(0, std::memory_order_relaxed);
+        accumulator->calls[p].store(0, std::memory_order_relaxed);
+      }
+  }
+
+ private:
+  struct Accumulator {
+    std::array<std::atomic<std::uint64_t>, number_of_phases> nanoseconds{};
+    std::array<std::atomic<std::uint64_t>, number_of_phases> calls{};
+  };
+
+  static std::mutex& mutex() {
+    static std::mutex m;
+    return m;
+  }
+
+  /*! The accumulators of every thread that has timed a phase */
+  static std::vector<std::shared_ptr<Accumulator>>& accumulators() {
+    static std::vector<std::shared_ptr<Accumulator>> a;
+    return a;
+  }
+
+  /*! The accumulators of this thread, registered on first use */
+  static Accumulator& local() {
+    thread_local const std::shared_ptr<Accumulator> accumulator = [] {
+      auto a = std::make_shared<Accumulator>();
+      std::lock_guard<std::mutex> lock(mutex());
+      accumulators().push_back(a);
+      return a;
+    }();
+    return *accumulator;
+  }
+};
+
+/*!
+ * \class ScopedPhase
+ * \brief Times a phase from its construction to its destruction, less the
+ *        phases within it
+ */
+
+class ScopedPhase {
+ public:
+  explicit ScopedPhase(const Phase phase)
+      : phase_(phase), outer_(innermost()) {
+    innermost() = this;
+  }
+
+  ~ScopedPhase() {
+    const std::uint64_t elapsed = timer_.elapsed().count();
+    innermost() = outer_;
+    if (outer_)
+      outer_->inner_ += elapsed;
+    PhaseProfiler::add(phase_, elapsed - std::min(inner_, elapsed));
+  }
+
+  ScopedPhase(const ScopedPhase&) = delete;
+  ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+ private:
+  const Phase phase_;
+  ScopedPhase* const outer_;  /*!< The phase this one is within, if any */
+  std::uint64_t inner_ = 0;   /*!< Nanoseconds of the phases within */
+  const PhaseTimer timer_;    // Last, so that it starts last
+
+  /*! The innermost phase running on this thread */
+  static ScopedPhase*& innermost() {
+    thread_local ScopedPhase* phase = nullptr;
+    return phase;
+  }
+};
+
+/*!
+ * \struct PhaseSummary
+ * \brief The time of the phases of some runs, and the wall time they took
+ */
+
+struct PhaseSummary {
+  PhaseProfiler::Totals totals;     /*!< Summed over the threads */
+  std::uint64_t wall_nanoseconds;   /*!< Wall time of the runs */
+
+  /*! Share of the wall time spent in a phase, by all the threads */
+  double share(const Phase phase) const {
+    return wall_nanoseconds
+               ? double(totals.nanoseconds[std::size_t(phase)]) /
+                     wall_nanoseconds
+               : 0.0;
+  }
+
+  /*!
+   * \brief Write a table of the phases that ran, one per line, with their
+   *        calls, total and mean time and share of the wall time
+   *
+   * With several threads the shares may add up to more than 100%; with
+   * one, what is left of the wall time is shown as "other".
+   */
+
+  void write_table(std::ostream& out) const {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::left << std::setw(24) << "phase" << std::right
+        << std::setw(12) << "calls" << std::setw(14) << "total [ms]"
+        << std::setw(14) << "mean [ns]" << std::setw(10) << "share"
+        << '\n' << std::fixed;
+    std::uint64_t attributed = 0;
+    for (std::size_t p = 0; p < number_of_phases; ++p) {
+      const std::uint64_t calls = totals.calls[p], ns = totals.nanoseconds[p];
+      attributed += ns;
+      if (calls == 0)
+        continue;
+      out << std::left << std::setw(24) << name(Phase(p)) << std::right
+          << std::setw(12) << calls << std::setw(14) << std::setprecision(3)
+          << ns * 1e-6 << std::setw(14) << std::setprecision(1)
+          << double(ns) / calls << std::setw(9) << std::setprecision(1)
+          << 100 * share(Phase(p)) << "%\n";
+    }
+    if (attributed < wall_nanoseconds)
+      out << std::left << std::setw(24) << "other" << std::right
+          << std::setw(12) << "" << std::setw(14) << std::setprecision(3)
+          << (wall_nanoseconds - attributed) * 1e-6 << std::setw(14) << ""
+          << std::setw(9) << std::setprecision(1)
+          << 100.0 * (wall_nanoseconds - attributed) / wall_nanoseconds
+          << "%\n";
+    out << std::left << std::setw(24) << "wall" << std::right << std::setw(12)
+        << "" << std::setw(14) << std::setprecision(3)
+        << wall_nanoseconds * 1e-6 << '\n';
+    out.flags(flags);
+    out.precision(precision);
+  }
+
+  /*!
+   * \brief Write the summary as a JSON object
+   *
+   * {"wall_ns": ..., "phases": [{"name": ..., "calls": ..., "ns": ...,
+   * "share": ...}, ...]}, with every phase, in the order of Phase.
+   */
+
+  void write_json(std::ostream& out) const {
+    const auto precision = out.precision(17);
+    out << "{\"wall_ns\": " << wall_nanoseconds << ", \"phases\": [";
+    for (std::size_t p = 0; p < number_of_phases; ++p)
+      out << (p ? ", " : "") << "{\"name\": \"" << name(Phase(p))
+          << "\", \"calls\": " << totals.calls[p]
+          << ", \"ns\": " << totals.nanoseconds[p]
+          << ", \"share\": " << share(Phase(p)) << '}';
+    out << "]}";
+    out.precision(precision);
+  }
+};
+
+/*!
+ * \class ProfiledRun
+ * \brief Summarizes the phases timed from its construction on
+ *
+ * The phases of all the threads count, hence runs summarized apart should
+ * not overlap; neither should PhaseProfiler::reset be called meanwhile.
+ */
+
+class ProfiledRun {
+ public:
+  ProfiledRun() : start_(PhaseProfiler::totals()) {}
+
+  /*! The phases timed and the wall time since construction */
+  PhaseSummary summary() const {
+    PhaseSummary summary{PhaseProfiler::totals(),
+                         std::uint64_t(timer_.elapsed().count())};
+    for (std::size_t p = 0; p < number_of_phases; ++p) {
+      summary.totals.nanoseconds[p] -= start_.nanoseconds[p];
+      summary.totals.calls[p] -= start_.calls[p];
+    }
+    return summary;
+  }
+
+ private:
+  const PhaseProfiler::Totals start_;
+  const Timer timer_;
+};
+
+}  // namespace DE
+
+#define DE_PROFILE_CONCAT_(a, b) a##b
+#define DE_PROFILE_CONCAT(a, b) DE_PROFILE_CONCAT_(a, b)
+
+/*! Time the rest of the scope as the Phase \p phase */
+#ifdef DE_PROFILE_PHASES
+#define DE_PROFILE_PHASE(phase)                                    \
+  const ::DE::ScopedPhase DE_PROFILE_CONCAT(de_scoped_phase_, __LINE__)( \
+      ::DE::Phase::phase)
+#else
+#define DE_PROFILE_PHASE(phase) static_cast<void>(0)
+#endif
+
+#endif  // DE_PROFILER_HPP
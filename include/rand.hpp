@@ -4,20 +4,257 @@
  * \version 1.0
  *
  * \brief Implementation of a random engine
+ *
+ * Random numbers come from the counter-based Philox-4x32-10 generator
+ * \cite Salmon2011. A stream is identified by the global SEED, the run, the
+ * generation, the individual and the purpose of its draws, so the numbers an
+ * individual sees do not depend on which thread handles it or in which
+ * order. Algorithms bind a stream to the current thread with
+ * ScopedRandomStream while they work on an individual; the rand_* functions
+ * below (also used by the problems) draw from the bound stream. Without a
+ * bound stream, every thread draws from its own fallback stream.
  */
 
 #ifndef RANDOM_ENGINE
 #define RANDOM_ENGINE
 
-#include <boost/random/uniform_real_distribution.hpp>
-#include <boost/random/uniform_int_distribution.hpp>
-#include <boost/random/normal_distribution.hpp>
-#include <boost/random/cauchy_distribution.hpp>
-#include <boost/random/mersenne_twister.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
 #include <assert.h>
 
 extern size_t SEED; /*!< The seed must be defined externally */
 
+/*! What the numbers of a random stream are used for, part of its key */
+enum class RandomPurpose : std::uint32_t {
+  initialization, /*!< Randomizing the initial population */
+  trial,          /*!< Building a trial vector */
+  selection,      /*!< Selection and archive maintenance */
+  parameters,     /*!< Algorithm-specific parameters (e.g. DEGL weights) */
+  generation,     /*!< Draws made once per generation for all individuals */
+  unbound         /*!< Fallback stream of a thread */
+};
+
+/*!
+ * \struct RandomStreamKey
+ * \brief Identifies a random stream
+ */
+
+struct RandomStreamKey {
+  std::uint64_t seed;       /*!< The global seed */
+  std::uint32_t run;        /*!< Index of the (independent) run, < 2^28 */
+  std::uint32_t generation; /*!< Index of the generation */
+  std::uint32_t individual; /*!< Index of the individual */
+  RandomPurpose purpose;    /*!< What the numbers are used for */
+};
+
+/*!
+ * \class Philox4x32
+ * \brief The Philox-4x32-10 counter-based random engine
+ *
+ * Satisfies the UniformRandomBitGenerator requirements. The 64-bit key is
+ * the seed; the 128-bit counter holds the run and purpose, the generation,
+ * the individual, and the index of the block within the stream.
+ */
+
+class Philox4x32 {
+ public:
+  using result_type = std::uint32_t; /*!< Type of the generated numbers */
+  using counter_type = std::array<std::uint32_t, 4>; /*!< 128-bit counter */
+  using key_type = std::array<std::uint32_t, 2>;     /*!< 64-bit key */
+
+  /*!
+   * \brief Start the stream identified by \p key
+   */
+
+  explicit Philox4x32(const RandomStreamKey& key)
+      : key_{{std::uint32_t(key.seed), std::uint32_t(key.seed >> 32)}},
+        counter_{{0, key.individual, key.generation,
+                  (key.run << 4) | std::uint32_t(key.purpose)}},
+        index_(4) {
+    assert(key.run < (1u << 28));
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return 0xFFFFFFFF; }
+
+  /*! Next number of the stream */
+  result_type operator()() {
+    if (index_ == 4) {
+      block_ = generate(counter_, key_);
+      ++counter_[0];
+      index_ = 0;
+    }
+    return block_[index_++];
+  }
+
+  /*!
+   * \brief Fill \p out with the next \p n numbers of the stream
+   *
+   * Equivalent to calling operator() \p n times, but whole blocks are
+   * generated several at a time in structure-of-arrays form, which the
+   * compiler turns into SIMD code.
+   *
+   * \param out : Output, \p n numbers
+   * \param n   : How many numbers to generate
+   */
+
+  void fill(result_type* out, std::size_t n) {
+    for (; n > 0 && index_ < 4; --n)
+      *out++ = block_[index_++];
+    constexpr std::size_t lanes = 8;  // Blocks generated at once
+    for (; n >= 4 * lanes; n -= 4 * lanes, out += 4 * lanes) {
+      std::uint32_t c0[lanes], c1[lanes], c2[lanes], c3[lanes];
+      for (std::size_t l = 0; l < lanes; ++l) {
+        c0[l] = counter_[0] + std::uint32_t(l);
+        c1[l] = counter_[1];
+        c2[l] = counter_[2];
+        c3[l] = counter_[3];
+      }
+      key_type key = key_;
+      for (std::size_t round = 0; round < 10; ++round) {
+        for (std::size_t l = 0; l < lanes; ++l) {
+          const std::uint64_t p0 = std::uint64_t(0xD2511F53) * c0[l],
+                              p1 = std::uint64_t(0xCD9E8D57) * c2[l];
+          c0[l] = std::uint32_t(p1 >> 32) ^ c1[l] ^ key[0];
+          c1[l] = std::uint32_t(p1);
+          c2[l] = std::uint32_t(p0 >> 32) ^ c3[l] ^ key[1];
+          c3[l] = std::uint32_t(p0);
+        }
+        key[0] += 0x9E3779B9;
+        key[1] += 0xBB67AE85;
+      }
+      for (std::size_t l = 0; l < lanes; ++l) {
+        out[4 * l] = c0[l];
+        out[4 * l + 1] = c1[l];
+        out[4 * l + 2] = c2[l];
+        out[4 * l + 3] = c3[l];
+      }
+      counter_[0] += lanes;
+    }
+    for (; n > 0; --n)
+      *out++ = (*this)();
+  }
+
+  /*!
+   * \brief The Philox-4x32-10 bijection
+   *
+   * \param counter : The counter to be encrypted
+   * \param key     : The key
+   *
+   * \return Four random 32-bit numbers
+   */
+
+  static counter_type generate(counter_type counter, key_type key) {
+    for (std::size_t round = 0; round < 10; ++round) {
+      const std::uint64_t p0 = std::uint64_t(0xD2511F53) * counter[0],
+                          p1 = std::uint64_t(0xCD9E8D57) * counter[2];
+      counter = {{std::uint32_t(p1 >> 32) ^ counter[1] ^ key[0],
+                  std::uint32_t(p1),
+                  std::uint32_t(p0 >> 32) ^ counter[3] ^ key[1],
+                  std::uint32_t(p0)}};
+      key[0] += 0x9E3779B9;
+      key[1] += 0xBB67AE85;
+    }
+    return counter;
+  }
+
+ private:
+  key_type key_;         /*!< The key (seed) */
+  counter_type counter_; /*!< Counter of the next block */
+  counter_type block_;   /*!< The current block of numbers */
+  std::size_t index_;    /*!< Next unused number of block_ */
+};
+
+/*!
+ * \brief The stream bound to the current thread (nullptr if none)
+ */
+
+inline Philox4x32*& bound_random_engine() {
+  thread_local Philox4x32* engine = nullptr;
+  return engine;
+}
+
+/*!
+ * \class ScopedRandomStream
+ * \brief Bind a random stream to the current thread for a scope
+ *
+ * Scopes may nest; the previously bound stream is restored on exit.
+ */
+
+class ScopedRandomStream {
+ public:
+  explicit ScopedRandomStream(const RandomStreamKey& key)
+      : engine_(key), previous_(bound_random_engine()) {
+    bound_random_engine() = &engine_;
+  }
+
+  ~ScopedRandomStream() { bound_random_engine() = previous_; }
+
+  ScopedRandomStream(const ScopedRandomStream&) = delete;
+  ScopedRandomStream& operator=(const ScopedRandomStream&) = delete;
+
+ private:
+  Philox4x32 engine_;     /*!< The bound stream */
+  Philox4x32* previous_;  /*!< Stream bound before this one */
+};
+
+/*!
+ * \brief The engine all rand_* functions draw from
+ *
+ * \return The stream bound to this thread, or else the thread's fallback
+ */
+
+inline Philox4x32& random_engine() {
+  if (Philox4x32* engine = bound_random_engine())
+    return *engine;
+  static std::atomic<std::uint32_t> threads(0);
+  thread_local Philox4x32 fallback(
+      {SEED, 0, 0, threads++, RandomPurpose::unbound});
+  return fallback;
+}
+
+/*!
+ * \brief Number the independent runs of a program
+ *
+ * \return 0 on the first call, then 1, 2, ...
+ */
+
+inline std::uint32_t next_run() {
+  static std::atomic<std::uint32_t> run(0);
+  return run++;
+}
+
+/*!
+ * \brief Map 32 random bits to an index within [0, range)
+ *
+ * Uses a multiplication instead of a division (Lemire's method); the bias
+ * is below range / 2^32.
+ *
+ * \param bits  : 32 random bits
+ * \param range : Number of possible indices
+ */
+
+inline std::size_t uniform_index(const std::uint32_t bits,
+                                 const std::size_t range) {
+  assert(range > 0 && range <= (std::size_t(1) << 32));
+  return (std::uint64_t(bits) * range) >> 32;
+}
+
+/*!
+ * \brief Map 64 random bits to a double within [0, 1) with 53-bit precision
+ *
+ * \param high : 32 random bits
+ * \param low  : 32 more random bits
+ */
+
+inline double uniform_unit(const std::uint32_t high, const std::uint32_t low) {
+  return ((high >> 5) * 67108864.0 + (low >> 6)) * (1.0 / 9007199254740992.0);
+}
+
 /*!
  * \brief Generate a random float between (min, max) from a uniform distribution
  *
@@ -29,9 +266,9 @@ extern size_t SEED; /*!< The seed must be defined externally */
 
 inline double rand_uniform_real(const double min, const double max) {
   assert(min < max);
-  thread_local boost::random::mt19937 generator(SEED);
-  boost::random::uniform_real_distribution<> dist(min, max);
-  return dist(generator);
+  auto& engine = random_engine();
+  const auto high = engine();
+  return min + uniform_unit(high, engine()) * (max - min);
 }
 
 /**
@@ -45,14 +282,15 @@ inline double rand_uniform_real(const double min, const double max) {
 
 inline int rand_uniform_int(const float min, const float max) {
   assert(min < max);
-  thread_local boost::random::mt19937 generator(SEED);
-  boost::random::uniform_int_distribution<> dist(min, max);
-  return dist(generator);
+  return int(min) + int(uniform_index(random_engine()(),
+                                      std::size_t(max - min) + 1));
 }
 
 /*!
  * \brief Generate a random float from a normal distribution
  *
+ * Uses the Box-Muller transform.
+ *
  * \param mean  : mean value of the normal distribution
  * \param sigma : standard deviation of the normal distribution
  *
@@ -60,24 +298,141 @@ inline int rand_uniform_int(const float min, const float max) {
  */
 
 inline double rand_normal(const double mean, const double sigma) {
-  thread_local boost::random::mt19937 generator(SEED);
-  boost::random::normal_distribution<> dist(mean, sigma);
-  return dist(generator);
+  auto& engine = random_engine();
+  std::uint32_t bits[4];
+  engine.fill(bits, 4);
+  const double u1 = 1.0 - uniform_unit(bits[0], bits[1]),
+               u2 = uniform_unit(bits[2], bits[3]);
+  return mean +
+         sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(2 * M_PI * u2);
 }
 
 /*!
  * \brief Generate a random float from a Cauchy distribution
  *
- * \param mean  : mean value of the Cauchy distribution
- * \param sigma : standard deviation of the Cauchy distribution
+ * Uses the inverse of the cumulative distribution function.
+ *
+ * \param location : location (median) of the Cauchy distribution
+ * \param scale    : scale (half width at half maximum) of the distribution
  *
  * \return A random double
  */
 
-inline double rand_cauchy(const double mean, const double sigma) {
-  thread_local boost::random::mt19937 generator(SEED);
-  boost::random::normal_distribution<> dist(mean, sigma);
-  return dist(generator);
+inline double rand_cauchy(const double location, const double scale) {
+  return location + scale * std::tan(M_PI * (rand_uniform_real(0, 1) - 0.5));
+}
+
+/*! Number of variates the fill_* functions produce per batch */
+constexpr std::size_t RANDOM_BATCH_SIZE = 256;
+
+/*!
+ * \brief Fill \p out with raw random bits
+ *
+ * \param out : Output, \p n random numbers
+ * \param n   : How many numbers to generate
+ */
+
+inline void fill_random_bits(std::uint32_t* out, const std::size_t n) {
+  random_engine().fill(out, n);
+}
+
+/*!
+ * \brief Fill \p out with uniform variates within [min, max)
+ *
+ * \param out : Output, \p n variates
+ * \param n   : How many variates to generate
+ * \param min : lower value
+ * \param max : upper value
+ */
+
+inline void fill_uniform_real(double* out,
+                              const std::size_t n,
+                              const double min,
+                              const double max) {
+  assert(min < max);
+  std::uint32_t bits[2 * RANDOM_BATCH_SIZE];
+  for (std::size_t done = 0; done < n; done += RANDOM_BATCH_SIZE) {
+    const std::size_t m = std::min(RANDOM_BATCH_SIZE, n - done);
+    random_engine().fill(bits, 2 * m);
+    for (std::size_t i = 0; i < m; ++i)
+      out[done + i] =
+          min + uniform_unit(bits[2 * i], bits[2 * i + 1]) * (max - min);
+  }
+}
+
+/*!
+ * \brief Fill \p out with normal variates
+ *
+ * Uses the Box-Muller transform; both variates of every pair are used.
+ *
+ * \param out   : Output, \p n variates
+ * \param n     : How many variates to generate
+ * \param mean  : mean value of the normal distribution
+ * \param sigma : standard deviation of the normal distribution
+ */
+
+inline void fill_normal(double* out,
+                        const std::size_t n,
+                        const double mean,
+                        const double sigma) {
+  std::uint32_t bits[2 * RANDOM_BATCH_SIZE];
+  for (std::size_t done = 0; done < n; done += RANDOM_BATCH_SIZE) {
+    const std::size_t m = std::min(RANDOM_BATCH_SIZE, n - done),
+                      pairs = (m + 1) / 2;
+    random_engine().fill(bits, 4 * pairs);
+    for (std::size_t p = 0; p < pairs; ++p) {
+      const double u1 = 1.0 - uniform_unit(bits[4 * p], bits[4 * p + 1]),
+                   u2 = uniform_unit(bits[4 * p + 2], bits[4 * p + 3]);
+      const double r = sigma * std::sqrt(-2.0 * std::log(u1)),
+                   theta = 2 * M_PI * u2;
+      out[done + 2 * p] = mean + r * std::cos(theta);
+      if (2 * p + 1 < m)
+        out[done + 2 * p + 1] = mean + r * std::sin(theta);
+    }
+  }
+}
+
+/*!
+ * \brief Fill \p out with Cauchy variates
+ *
+ * \param out      : Output, \p n variates
+ * \param n        : How many variates to generate
+ * \param location : location (median) of the Cauchy distribution
+ * \param scale    : scale (half width at half maximum) of the distribution
+ */
+
+inline void fill_cauchy(double* out,
+                        const std::size_t n,
+                        const double location,
+                        const double scale) {
+  fill_uniform_real(out, n, 0, 1);
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = location + scale * std::tan(M_PI * (out[i] - 0.5));
+}
+
+/*!
+ * \brief Fill a binary crossover mask
+ *
+ * Every element is set independently with probability \p Cr.
+ *
+ * \param mask : Output, \p n flags
+ * \param n    : Number of genes
+ * \param Cr   : The crossover factor
+ */
+
+inline void fill_crossover_mask(std::uint8_t* mask,
+                                const std::size_t n,
+                                const double Cr) {
+  const std::uint64_t threshold =
+      Cr <= 0 ? 0 : Cr >= 1 ? std::uint64_t(1) << 32
+                            : std::uint64_t(Cr * 4294967296.0);
+  std::uint32_t bits[RANDOM_BATCH_SIZE];
+  for (std::size_t done = 0; done < n; done += RANDOM_BATCH_SIZE) {
+    const std::size_t m = std::min(RANDOM_BATCH_SIZE, n - done);
+    random_engine().fill(bits, m);
+    for (std::size_t i = 0; i < m; ++i)
+      mask[done + i] = std::uint64_t(bits[i]) < threshold;
+  }
 }
 
 #endif  // RANDOM_ENGINE
@@ -0,0 +1,125 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief A bounded lock-free queue
+ */
+
+#ifndef DE_RING_BUFFER_HPP
+#define DE_RING_BUFFER_HPP
+
+#include <assert.h>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace DE {
+
+/*!
+ * \class RingBuffer
+ * \brief A bounded queue that any number of threads may push to and pop
+ *        from, without locks
+ *
+ * Every slot carries a sequence number telling whether it is free for the
+ * push of a given turn or holds the value for the pop of that turn
+ * (D. Vyukov's bounded MPMC queue). push and pop claim their position with
+ * a compare-and-swap and never wait on each other: a full buffer fails the
+ * push, an empty one the pop.
+ *
+ * \tparam T : Type of the values, copyable and default constructible
+ */
+
+template <class T>
+class RingBuffer {
+ public:
+  /*!
+   * \brief Create an empty buffer
+   *
+   * \param capacity : Number of values held at most, a power of two
+   */
+
+  explicit RingBuffer(const std::size_t capacity)
+      : mask_(capacity - 1), slots_(new Slot[capacity]) {
+    assert(capacity >= 2 && (capacity & mask_) == 0);
+    for (std::size_t i = 0; i < capacity; ++i)
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  /*!
+   * \brief Append a value
+   *
+   * \return False, and nothing is appended, if the buffer is full
+   */
+
+  bool push(const T& value) {
+    std::size_t position = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[position & mask_];
+      const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto difference = std::ptrdiff_t(sequence - position);
+      if (difference == 0) {
+        if (tail_.compare_exchange_weak(position, position + 1,
+                                        std::memory_order_relaxed)) {
+          slot.value = value;
+          slot.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false;  // full
+      } else {
+        position = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /*!
+   * \brief Remove the oldest value
+   *
+   * \param value : Output, the value removed
+   *
+   * \return False, and \p value is untouched, if the buffer is empty
+   */
+
+  bool pop(T& value) {
+    std::size_t position = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[position & mask_];
+      const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto difference = std::ptrdiff_t(sequence - (position + 1));
+      if (difference == 0) {
+        if (head_.compare_exchange_weak(position, position + 1,
+                                        std::memory_order_relaxed)) {
+          value = slot.value;
+          slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false;  // empty
+      } else {
+        position = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /*! Number of values held at most */
+  std::size_t capacity() const { return mask_ + 1; }
+
+ private:
+  struct Slot {
+    std::atomic<std::size_t> sequence; /*!< Turn of the slot, see above */
+    T value;
+  };
+
+  const std::size_t mask_;         /*!< Capacity - 1 */
+  std::unique_ptr<Slot[]> slots_;  /*!< The values */
+  /*! Positions of the next push and pop, on cache lines of their own */
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  alignas(64) std::atomic<std::size_t> head_{0};
+};
+
+}  // namespace DE
+#endif  // DE_RING_BUFFER_HPP
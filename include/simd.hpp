@@ -0,0 +1,379 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief Vectorized kernels of the CEC basic functions, dispatched at runtime
+ *
+ * The kernels are compiled for SSE2, AVX2 (with FMA) and AVX-512F, whatever
+ * the flags of the build, and the widest one the CPU supports is chosen at
+ * runtime through CPUID. The basic functions call them from evaluate while
+ * a vector instruction set is active; otherwise, and on other architectures,
+ * they keep their scalar loops, which call libm. The product with the
+ * rotation matrix of CECFunction, for one chromosome or a batch, is also a
+ * kernel; it adds in the order of the scalar loop and is exact to it. So
+ * are the bound handling policies of SimpleFitnessFunction, which involve
+ * no rounding beyond that of the scalar loops.
+ *
+ * The kernels replace libm's sin and cos with sine_cosine (kernels.hpp):
+ *
+ * - For |x| <= sine_cosine_limit (2^20) the error is below 1 ulp for
+ *   |x| <= pi/4 and below 1.5 ulp elsewhere (the reduction adds at most
+ *   2^-60 |x| absolute error, which matters only next to the zeros).
+ * - Larger, infinite or NaN arguments are delegated to libm, lane by lane.
+ *
+ * sqrt and the arithmetic are exact IEEE operations, and the terms are added
+ * in the order of the scalar loops, hence the functions differ from them
+ * only by the error of sin and cos. The functions with kernels are Rastrigin,
+ * non-continuous Rastrigin, Lunacek bi-Rastrigin, Levy, Schwefel, Ackley,
+ * Griewank and expanded Griewank plus Rosenbrock. The others keep their
+ * scalar loops on purpose:
+ *
+ * - HappyCat, HGBat, ... have no transcendental calls in their loops, hence
+ *   nothing to gain.
+ * - Schaffer's F7 calls pow per pair of genes, besides sin, and Katsuura
+ *   calls pow per gene. There is no vector pow here, and pow costs more
+ *   than the rest of the term, so a kernel would still call libm per lane.
+ * - Weierstrass takes the cosine of 2 pi 3^k (x_i + 0.5) for k up to 20,
+ *   which exceeds sine_cosine_limit from about k = 12 on (x_i is within
+ *   [-0.5, 0.5] once scaled), where the lanes would be delegated to libm
+ *   anyway.
+ *
+ * The product with the rotation and the bound handling are also compiled on
+ * floats (FloatKernels), with twice the lanes, for the functions on float
+ * genes; they are exact to the scalar loops on floats as well. The terms of
+ * the basic functions are computed in double on either type of genes.
+ */
+
+#ifndef DE_SIMD_HPP
+#define DE_SIMD_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "simd/scalar.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DE_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define DE_SIMD_X86 0
+#endif
+
+namespace DE {
+
+/*!
+ * \namespace SIMD
+ * \brief Vectorized math and the kernels of the CEC basic functions
+ */
+
+namespace SIMD {
+
+/*! Largest |x| whose sine and cosine are not delegated to libm */
+constexpr double sine_cosine_limit = 1048576.0;
+
+/*! \enum InstructionSet
+ *  \brief The instruction sets with kernels, from the narrowest
+ */
+
+enum class InstructionSet { scalar, sse2, avx2, avx512 };
+
+/*!
+ * \struct Kernels
+ * \brief The kernels compiled for an instruction set
+ *
+ * All take a chromosome \p x of \p n genes.
+ */
+
+struct Kernels {
+  /*! y[i] = sin(x[i]) */
+  void (*sin)(const double* x, double* y, std::size_t n);
+  /*! y[i] = cos(x[i]) */
+  void (*cos)(const double* x, double* y, std::size_t n);
+  /*! Rastrigin's function */
+  double (*rastrigin)(const double* x, std::size_t n);
+  /*! Sum of cos(2 pi x[i]) */
+  double (*sum_cos_2pi)(const double* x, std::size_t n);
+  /*! sums = {sum of x[i]^2, sum of cos(2 pi x[i])} */
+  void (*ackley_sums)(const double* x, std::size_t n, double* sums);
+  /*! Griewank's function */
+  double (*griewank)(const double* x, std::size_t n);
+  /*! Schwefel's function */
+  double (*schwefel)(const double* x, std::size_t n);
+  /*! Levy function */
+  double (*levy)(const double* x, std::size_t n);
+  /*! Expanded Griewank's plus Rosenbrock's function */
+  double (*griewank_rosenbrock)(const double* x, std::size_t n);
+  /*!
+   * y = M ((x - shift) scale), where row j of \p rotation (of \p stride
+   * doubles) holds column j of M; \p shift may be null
+   */
+  void (*transform)(const double* x, const double* shift, double scale,
+                    const double* rotation, std::size_t stride, std::size_t n,
+                    double* y);
+  /*!
+   * y = x M^T for \p rows chromosomes, row r of x at x + r x_stride and of y
+   * at y + r y_stride, rotation as in transform. The rows of y and of the
+   * rotation are read and written up to a whole number of vectors (the
+   * padding of the rotation must be zero, that of y is zeroed).
+   */
+  void (*rotate_batch)(const double* x, std::size_t x_stride, std::size_t rows,
+                       const double* rotation, std::size_t stride,
+                       std::size_t n, double* y, std::size_t y_stride);
+  /*! True if some x[i] is NaN or outside [lower[i], upper[i]] */
+  bool (*outside)(const double* x, const double* lower, const double* upper,
+                  std::size_t n);
+  /*! x[i] = lower[i] + x[i] (upper[i] - lower[i]), from [0, 1) to the bounds */
+  void (*scale_to_bounds)(double* x, const double* lower, const double* upper,
+                          std::size_t n);
+  /*! x[i] = max(lower[i], min(x[i], upper[i])) */
+  void (*clip)(double* x, const double* lower, const double* upper,
+               std::size_t n);
+  /*! x[i] mirrored on the bound it crossed, then clipped */
+  void (*reflect)(double* x, const double* lower, const double* upper,
+                  std::size_t n);
+  /*! x[i] beyond a bound = the midpoint of the bound and parent[i] */
+  void (*midpoint)(double* x, const double* parent, const double* lower,
+                   const double* upper, std::size_t n);
+};
+
+/*!
+ * \struct FloatKernels
+ * \brief The kernels on floats compiled for an instruction set
+ *
+ * As the ones of the same name in Kernels.
+ */
+
+struct FloatKernels {
+  void (*transform)(const float* x, const float* shift, float scale,
+                    const float* rotation, std::size_t stride, std::size_t n,
+                    float* y);
+  void (*rotate_batch)(const float* x, std::size_t x_stride, std::size_t rows,
+                       const float* rotation, std::size_t stride,
+                       std::size_t n, float* y, std::size_t y_stride);
+  bool (*outside)(const float* x, const float* lower, const float* upper,
+                  std::size_t n);
+  void (*clip)(float* x, const float* lower, const float* upper,
+               std::size_t n);
+  void (*reflect)(float* x, const float* lower, const float* upper,
+                  std::size_t n);
+  void (*midpoint)(float* x, const float* parent, const float* lower,
+                   const float* upper, std::size_t n);
+};
+
+// The kernels are compiled without contracting a * b + c into FMA, which
+// GCC does by default on targets with FMA: the arguments of sin and cos
+// would differ from those of the scalar loops by an ulp, and their results
+// by far more. Clang contracts only within expressions, never across the
+// operators of the vectors.
+#if !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+/*!
+ * \namespace generic
+ * \brief The kernels on Scalar: portable, used where nothing else is
+ */
+
+namespace generic {
+using Vec = Scalar;
+using VecF = ScalarF;
+#include "simd/kernels.hpp"
+}  // namespace generic
+
+#if DE_SIMD_X86
+
+namespace sse2 {
+#include "simd/sse2.hpp"
+#include "simd/kernels.hpp"
+}  // namespace sse2
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+namespace avx2 {
+#include "simd/avx2.hpp"
+#include "simd/kernels.hpp"
+}  // namespace avx2
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f,avx2,fma"))), \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx2,fma")
+#endif
+namespace avx512 {
+#include "simd/avx512.hpp"
+#include "simd/kernels.hpp"
+}  // namespace avx512
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif  // DE_SIMD_X86
+
+#if !defined(__clang__)
+#pragma GCC pop_options
+#endif
+
+namespace detail {
+
+#define DE_SIMD_KERNELS(isa)                                              \
+  {                                                                       \
+    &isa::sin, &isa::cos, &isa::rastrigin, &isa::sum_cos_2pi,             \
+        &isa::ackley_sums, &isa::griewank, &isa::schwefel, &isa::levy,    \
+        &isa::griewank_rosenbrock, &isa::transform, &isa::rotate_batch,   \
+        &isa::outside, &isa::scale_to_bounds, &isa::clip, &isa::reflect,  \
+        &isa::midpoint                                                    \
+  }
+
+#define DE_SIMD_FLOAT_KERNELS(isa)                                       \
+  {                                                                      \
+    &isa::transform, &isa::rotate_batch, &isa::outside, &isa::clip,      \
+        &isa::reflect, &isa::midpoint                                    \
+  }
+
+/*! The kernels of every instruction set, indexed by InstructionSet */
+inline const Kernels* kernel_table() {
+#if DE_SIMD_X86
+  static const Kernels table[] = {DE_SIMD_KERNELS(generic),
+                                  DE_SIMD_KERNELS(sse2), DE_SIMD_KERNELS(avx2),
+                                  DE_SIMD_KERNELS(avx512)};
+#else
+  static const Kernels table[] = {
+      DE_SIMD_KERNELS(generic), DE_SIMD_KERNELS(generic),
+      DE_SIMD_KERNELS(generic), DE_SIMD_KERNELS(generic)};
+#endif
+  return table;
+}
+
+/*! The float kernels of every instruction set, indexed by InstructionSet */
+inline const FloatKernels* float_kernel_table() {
+#if DE_SIMD_X86
+  static const FloatKernels table[] = {
+      DE_SIMD_FLOAT_KERNELS(generic), DE_SIMD_FLOAT_KERNELS(sse2),
+      DE_SIMD_FLOAT_KERNELS(avx2), DE_SIMD_FLOAT_KERNELS(avx512)};
+#else
+  static const FloatKernels table[] = {
+      DE_SIMD_FLOAT_KERNELS(generic), DE_SIMD_FLOAT_KERNELS(generic),
+      DE_SIMD_FLOAT_KERNELS(generic), DE_SIMD_FLOAT_KERNELS(generic)};
+#endif
+  return table;
+}
+
+#undef DE_SIMD_KERNELS
+#undef DE_SIMD_FLOAT_KERNELS
+
+}  // namespace detail
+
+/*!
+ * \brief The widest instruction set supported by the CPU (and the OS)
+ */
+
+inline InstructionSet detect_instruction_set() {
+#if DE_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return InstructionSet::avx512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return InstructionSet::avx2;
+  return InstructionSet::sse2;
+#else
+  return InstructionSet::scalar;
+#endif
+}
+
+namespace detail {
+
+inline std::atomic<InstructionSet>& active_instruction_set() {
+  static std::atomic<InstructionSet> active(detect_instruction_set());
+  return active;
+}
+
+}  // namespace detail
+
+/*!
+ * \brief The instruction set whose kernels are in use
+ */
+
+inline InstructionSet instruction_set() {
+  return detail::active_instruction_set().load(std::memory_order_relaxed);
+}
+
+/*!
+ * \brief Choose the instruction set of the kernels
+ *
+ * Mainly for testing and benchmarking; InstructionSet::scalar makes the
+ * functions use their scalar loops.
+ *
+ * \param isa : The requested instruction set
+ *
+ * \return The instruction set in use: \p isa, or the widest one supported if
+ *         the CPU lacks \p isa
+ */
+
+inline InstructionSet set_instruction_set(InstructionSet isa) {
+  isa = std::min(isa, detect_instruction_set());
+  detail::active_instruction_set().store(isa, std::memory_order_relaxed);
+  return isa;
+}
+
+/*!
+ * \brief True if the functions should call the vectorized kernels
+ */
+
+inline bool enabled() {
+  return instruction_set() != InstructionSet::scalar;
+}
+
+/*!
+ * \brief The kernels of the active instruction set
+ */
+
+inline const Kernels& kernels() {
+  return detail::kernel_table()[int(instruction_set())];
+}
+
+/*!
+ * \brief The float kernels of the active instruction set
+ */
+
+inline const FloatKernels& float_kernels() {
+  return detail::float_kernel_table()[int(instruction_set())];
+}
+
+/*!
+ * \brief Name of an instruction set
+ */
+
+inline const char* name(const InstructionSet isa) {
+  switch (isa) {
+    case InstructionSet::sse2:
+      return "SSE2";
+    case InstructionSet::avx2:
+      return "AVX2";
+    case InstructionSet::avx512:
+      return "AVX-512";
+    default:
+      return "scalar";
+  }
+}
+
+}  // namespace SIMD
+}  // namespace DE
+#endif  // DE_SIMD_HPP
@@ -0,0 +1,160 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief Vectors of four doubles and of eight floats on AVX2 and FMA
+ *
+ * Included by simd.hpp inside namespace DE::SIMD::avx2, in a region compiled
+ * for the avx2 and fma targets.
+ */
+
+#ifndef DE_SIMD_AVX2_HPP
+#define DE_SIMD_AVX2_HPP
+
+/*!
+ * \struct Vec
+ * \brief A vector of four doubles
+ */
+
+struct Vec {
+  static constexpr std::size_t width = 4; /*!< Number of lanes */
+  __m256d v;                              /*!< The lanes */
+
+  Vec() = default;
+  Vec(const __m256d x) : v(x) {}
+  Vec(const double x) : v(_mm256_set1_pd(x)) {}
+  static Vec load(const double* p) { return _mm256_loadu_pd(p); }
+  void store(double* p) const { _mm256_storeu_pd(p, v); }
+};
+
+inline Vec operator+(const Vec a, const Vec b) {
+  return _mm256_add_pd(a.v, b.v);
+}
+
+inline Vec operator-(const Vec a, const Vec b) {
+  return _mm256_sub_pd(a.v, b.v);
+}
+
+inline Vec operator*(const Vec a, const Vec b) {
+  return _mm256_mul_pd(a.v, b.v);
+}
+
+inline Vec operator/(const Vec a, const Vec b) {
+  return _mm256_div_pd(a.v, b.v);
+}
+
+inline Vec operator&(const Vec a, const Vec b) {
+  return _mm256_and_pd(a.v, b.v);
+}
+
+inline Vec operator|(const Vec a, const Vec b) {
+  return _mm256_or_pd(a.v, b.v);
+}
+
+inline Vec operator^(const Vec a, const Vec b) {
+  return _mm256_xor_pd(a.v, b.v);
+}
+
+inline Vec andnot(const Vec a, const Vec b) {
+  return _mm256_andnot_pd(a.v, b.v);
+}
+
+inline Vec operator<(const Vec a, const Vec b) {
+  return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ);
+}
+
+inline Vec operator<=(const Vec a, const Vec b) {
+  return _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ);
+}
+
+inline Vec operator>(const Vec a, const Vec b) {
+  return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ);
+}
+
+inline Vec fma(const Vec a, const Vec b, const Vec c) {
+  return _mm256_fmadd_pd(a.v, b.v, c.v);
+}
+
+inline Vec sqrt(const Vec a) { return _mm256_sqrt_pd(a.v); }
+inline Vec abs(const Vec a) { return andnot(Vec(-0.0), a); }
+
+inline Vec select(const Vec mask, const Vec a, const Vec b) {
+  return _mm256_blendv_pd(b.v, a.v, mask.v);
+}
+
+inline Vec test_bit(const Vec a, const int bit) {
+  const __m256i b = _mm256_set1_epi64x(std::int64_t(1) << bit);
+  return _mm256_castsi256_pd(_mm256_cmpeq_epi64(
+      _mm256_and_si256(_mm256_castpd_si256(a.v), b), b));
+}
+
+inline bool all(const Vec mask) { return _mm256_movemask_pd(mask.v) == 0xf; }
+
+inline double reduce_add(const Vec a) {
+  double lanes[Vec::width];
+  a.store(lanes);
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+inline double reduce_mul(const Vec a) {
+  double lanes[Vec::width];
+  a.store(lanes);
+  return (lanes[0] * lanes[1]) * (lanes[2] * lanes[3]);
+}
+
+/*!
+ * \struct VecF
+ * \brief A vector of eight floats
+ */
+
+struct VecF {
+  static constexpr std::size_t width = 8; /*!< Number of lanes */
+  __m256 v;                               /*!< The lanes */
+
+  VecF() = default;
+  VecF(const __m256 x) : v(x) {}
+  VecF(const float x) : v(_mm256_set1_ps(x)) {}
+  static VecF load(const float* p) { return _mm256_loadu_ps(p); }
+  void store(float* p) const { _mm256_storeu_ps(p, v); }
+};
+
+inline VecF operator+(const VecF a, const VecF b) {
+  return _mm256_add_ps(a.v, b.v);
+}
+
+inline VecF operator-(const VecF a, const VecF b) {
+  return _mm256_sub_ps(a.v, b.v);
+}
+
+inline VecF operator*(const VecF a, const VecF b) {
+  return _mm256_mul_ps(a.v, b.v);
+}
+
+inline VecF operator/(const VecF a, const VecF b) {
+  return _mm256_div_ps(a.v, b.v);
+}
+
+inline VecF operator&(const VecF a, const VecF b) {
+  return _mm256_and_ps(a.v, b.v);
+}
+
+inline VecF operator<(const VecF a, const VecF b) {
+  return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ);
+}
+
+inline VecF operator<=(const VecF a, const VecF b) {
+  return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ);
+}
+
+inline VecF operator>(const VecF a, const VecF b) {
+  return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ);
+}
+
+inline VecF select(const VecF mask, const VecF a, const VecF b) {
+  return _mm256_blendv_ps(b.v, a.v, mask.v);
+}
+
+inline bool all(const VecF mask) { return _mm256_movemask_ps(mask.v) == 0xff; }
+
+#endif  // DE_SIMD_AVX2_HPP
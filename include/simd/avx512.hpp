@@ -0,0 +1,200 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief Vectors of eight doubles and of sixteen floats on AVX-512F
+ *
+ * Included by simd.hpp inside namespace DE::SIMD::avx512, in a region
+ * compiled for the avx512f target. Only AVX-512F is required: bitwise
+ * operations go through the integer domain and comparisons are expanded from
+ * mask registers into vector masks.
+ */
+
+#ifndef DE_SIMD_AVX512_HPP
+#define DE_SIMD_AVX512_HPP
+
+/*!
+ * \struct Vec
+ * \brief A vector of eight doubles
+ */
+
+struct Vec {
+  static constexpr std::size_t width = 8; /*!< Number of lanes */
+  __m512d v;                              /*!< The lanes */
+
+  Vec() = default;
+  Vec(const __m512d x) : v(x) {}
+  Vec(const double x) : v(_mm512_set1_pd(x)) {}
+  static Vec load(const double* p) { return _mm512_loadu_pd(p); }
+  void store(double* p) const { _mm512_storeu_pd(p, v); }
+};
+
+namespace detail {
+
+inline __m512i to_int(const Vec a) { return _mm512_castpd_si512(a.v); }
+inline Vec to_vec(const __m512i a) { return _mm512_castsi512_pd(a); }
+
+inline Vec expand(const __mmask8 mask) {
+  return to_vec(_mm512_maskz_set1_epi64(mask, -1));
+}
+
+inline __mmask8 compress(const Vec mask) {
+  return _mm512_test_epi64_mask(to_int(mask), to_int(mask));
+}
+
+}  // namespace detail
+
+inline Vec operator+(const Vec a, const Vec b) {
+  return _mm512_add_pd(a.v, b.v);
+}
+
+inline Vec operator-(const Vec a, const Vec b) {
+  return _mm512_sub_pd(a.v, b.v);
+}
+
+inline Vec operator*(const Vec a, const Vec b) {
+  return _mm512_mul_pd(a.v, b.v);
+}
+
+inline Vec operator/(const Vec a, const Vec b) {
+  return _mm512_div_pd(a.v, b.v);
+}
+
+inline Vec operator&(const Vec a, const Vec b) {
+  return detail::to_vec(
+      _mm512_and_si512(detail::to_int(a), detail::to_int(b)));
+}
+
+inline Vec operator|(const Vec a, const Vec b) {
+  return detail::to_vec(_mm512_or_si512(detail::to_int(a), detail::to_int(b)));
+}
+
+inline Vec operator^(const Vec a, const Vec b) {
+  return detail::to_vec(
+      _mm512_xor_si512(detail::to_int(a), detail::to_int(b)));
+}
+
+// The zero-masked forms of andnot and sqrt avoid the undefined pass-through
+// operand of the plain ones, which trips -Wuninitialized on GCC 12
+
+inline Vec andnot(const Vec a, const Vec b) {
+  return detail::to_vec(
+      _mm512_maskz_andnot_epi64(0xff, detail::to_int(a), detail::to_int(b)));
+}
+
+inline Vec operator<(const Vec a, const Vec b) {
+  return detail::expand(_mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ));
+}
+
+inline Vec operator<=(const Vec a, const Vec b) {
+  return detail::expand(_mm512_cmp_pd_mask(a.v, b.v, _CMP_LE_OQ));
+}
+
+inline Vec operator>(const Vec a, const Vec b) {
+  return detail::expand(_mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ));
+}
+
+inline Vec fma(const Vec a, const Vec b, const Vec c) {
+  return _mm512_fmadd_pd(a.v, b.v, c.v);
+}
+
+inline Vec sqrt(const Vec a) { return _mm512_maskz_sqrt_pd(0xff, a.v); }
+inline Vec abs(const Vec a) { return andnot(Vec(-0.0), a); }
+
+inline Vec select(const Vec mask, const Vec a, const Vec b) {
+  return _mm512_mask_blend_pd(detail::compress(mask), b.v, a.v);
+}
+
+inline Vec test_bit(const Vec a, const int bit) {
+  return detail::expand(_mm512_test_epi64_mask(
+      detail::to_int(a), _mm512_set1_epi64(std::int64_t(1) << bit)));
+}
+
+inline bool all(const Vec mask) { return detail::compress(mask) == 0xff; }
+
+inline double reduce_add(const Vec a) {
+  double lanes[Vec::width];
+  a.store(lanes);
+  return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+         ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+inline double reduce_mul(const Vec a) {
+  double lanes[Vec::width];
+  a.store(lanes);
+  return ((lanes[0] * lanes[1]) * (lanes[2] * lanes[3])) *
+         ((lanes[4] * lanes[5]) * (lanes[6] * lanes[7]));
+}
+
+/*!
+ * \struct VecF
+ * \brief A vector of sixteen floats
+ */
+
+struct VecF {
+  static constexpr std::size_t width = 16; /*!< Number of lanes */
+  __m512 v;                                /*!< The lanes */
+
+  VecF() = default;
+  VecF(const __m512 x) : v(x) {}
+  VecF(const float x) : v(_mm512_set1_ps(x)) {}
+  static VecF load(const float* p) { return _mm512_loadu_ps(p); }
+  void store(float* p) const { _mm512_storeu_ps(p, v); }
+};
+
+namespace detail {
+
+inline __m512i to_int(const VecF a) { return _mm512_castps_si512(a.v); }
+inline VecF to_vec_f(const __m512i a) { return _mm512_castsi512_ps(a); }
+
+inline VecF expand(const __mmask16 mask) {
+  return to_vec_f(_mm512_maskz_set1_epi32(mask, -1));
+}
+
+inline __mmask16 compress(const VecF mask) {
+  return _mm512_test_epi32_mask(to_int(mask), to_int(mask));
+}
+
+}  // namespace detail
+
+inline VecF operator+(const VecF a, const VecF b) {
+  return _mm512_add_ps(a.v, b.v);
+}
+
+inline VecF operator-(const VecF a, const VecF b) {
+  return _mm512_sub_ps(a.v, b.v);
+}
+
+inline VecF operator*(const VecF a, const VecF b) {
+  return _mm512_mul_ps(a.v, b.v);
+}
+
+inline VecF operator/(const VecF a, const VecF b) {
+  return _mm512_div_ps(a.v, b.v);
+}
+
+inline VecF operator&(const VecF a, const VecF b) {
+  return detail::to_vec_f(
+      _mm512_and_si512(detail::to_int(a), detail::to_int(b)));
+}
+
+inline VecF operator<(const VecF a, const VecF b) {
+  return detail::expand(_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ));
+}
+
+inline VecF operator<=(const VecF a, const VecF b) {
+  return detail::expand(_mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ));
+}
+
+inline VecF operator>(const VecF a, const VecF b) {
+  return detail::expand(_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ));
+}
+
+inline VecF select(const VecF mask, const VecF a, const VecF b) {
+  return _mm512_mask_blend_ps(detail::compress(mask), b.v, a.v);
+}
+
+inline bool all(const VecF mask) { return detail::compress(mask) == 0xffff; }
+
+#endif  // DE_SIMD_AVX512_HPP
@@ -0,0 +1,516 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief Vectorized math and the kernels of the CEC basic functions
+ *
+ * This file has no include guard: simd.hpp includes it once per instruction
+ * set, inside the namespace of the instruction set and after its Vec type,
+ * so that every function below is compiled for that target. The math is
+ * written once for any vector type V (Vec or Scalar); the loops run on Vec
+ * and finish the remainders on Scalar. The products with the rotation and
+ * the bound handling are also written once for the type of the genes, and
+ * run on floats with VecF and ScalarF.
+ */
+
+/*! \brief The vector and the single lane of a type of genes */
+template <class T>
+struct Lanes;
+
+template <>
+struct Lanes<double> {
+  using Wide = Vec;
+  using Narrow = Scalar;
+};
+
+template <>
+struct Lanes<float> {
+  using Wide = VecF;
+  using Narrow = ScalarF;
+};
+
+/*! \brief Round to the nearest integer, ties to even; |x| < 2^51 */
+template <class V>
+inline V round_nearest(const V x) {
+  const V magic(6755399441055744.0);  // 1.5 * 2^52
+  return (x + magic) - magic;
+}
+
+/*! \brief |mag| with the sign of \p sign */
+template <class V>
+inline V copysign(const V mag, const V sign) {
+  return abs(mag) | (sign & V(-0.0));
+}
+
+/*!
+ * \brief Sine of r + y on [-pi/4, pi/4], |y| < ulp(r) / 2
+ *
+ * Minimax polynomial of FreeBSD's k_sin.c, error below 2^-58 relative.
+ */
+
+template <class V>
+inline V sine_kernel(const V r, const V y) {
+  const V z = r * r, v = z * r;
+  const V p = V(8.33333333332248946124e-03) +
+              z * (V(-1.98412698298579493134e-04) +
+                   z * (V(2.75573137070700676789e-06) +
+                        z * (V(-2.50507602534068634195e-08) +
+                             z * V(1.58969099521155010221e-10))));
+  return r - ((z * (V(0.5) * y - v * p) - y) -
+              v * V(-1.66666666666666324348e-01));
+}
+
+/*!
+ * \brief Cosine of r + y on [-pi/4, pi/4], |y| < ulp(r) / 2
+ *
+ * Minimax polynomial of FreeBSD's k_cos.c, error below 2^-58 relative.
+ */
+
+template <class V>
+inline V cosine_kernel(const V r, const V y) {
+  const V z = r * r, w = z * z;
+  const V p = z * (V(4.16666666666666019037e-02) +
+                   z * (V(-1.38888888888741095749e-03) +
+                        z * V(2.48015872894767294178e-05))) +
+              w * w * (V(-2.75573143513906633035e-07) +
+                       z * (V(2.08757232129817482790e-09) +
+                            z * V(-1.13596475577881948265e-11)));
+  const V half_z = V(0.5) * z, one_minus = V(1.0) - half_z;
+  return one_minus + (((V(1.0) - one_minus) - half_z) + (z * p - r * y));
+}
+
+/*!
+ * \brief Sine (or cosine) of every lane
+ *
+ * x is reduced to r + y = x - n pi/2 with a three-part Cody-Waite reduction
+ * (FreeBSD's e_rem_pio2.c, good to 118 bits), exact for |n| < 2^20. The
+ * quadrant is read from the low bits of the rounded n. Lanes with |x| above
+ * sine_cosine_limit, infinite or NaN are computed by libm instead.
+ *
+ * \param x      : The arguments
+ * \param cosine : If true compute the cosine, else the sine
+ */
+
+template <class V>
+inline V sine_cosine(const V x, const bool cosine) {
+  const V magic(6755399441055744.0);  // 1.5 * 2^52
+  const V t = x * V(6.36619772367581382433e-01) + magic;
+  const V n = t - magic;
+  // The first product is exact, as pi/2 is split in 33-bit parts
+  const V r_1 = x - n * V(1.57079632673412561417e+00);
+  const V w_1 = n * V(6.07710050630396597660e-11);
+  const V r_2 = r_1 - w_1;
+  const V w_2 =
+      n * V(2.02226624879595063154e-21) - ((r_1 - r_2) - w_1);
+  const V r = r_2 - w_2, y = (r_2 - r) - w_2;
+
+  // Quadrant n (n + 1 for the cosine) modulo 4
+  const V quadrant = cosine ? t + V(1.0) : t;
+  V result = select(test_bit(quadrant, 0), cosine_kernel(r, y),
+                    sine_kernel(r, y));
+  result = result ^ (test_bit(quadrant, 1) & V(-0.0));
+
+  if (!all(abs(x) <= V(sine_cosine_limit))) {
+    double xs[V::width], results[V::width];
+    x.store(xs);
+    result.store(results);
+    for (std::size_t k = 0; k < V::width; ++k)
+      if (!(std::fabs(xs[k]) <= sine_cosine_limit))
+        results[k] = cosine ? std::cos(xs[k]) : std::sin(xs[k]);
+    result = V::load(results);
+  }
+  return result;
+}
+
+template <class V>
+inline V sine(const V x) {
+  return sine_cosine(x, false);
+}
+
+template <class V>
+inline V cosine(const V x) {
+  return sine_cosine(x, true);
+}
+
+/*!
+ * \brief Sum term(x[i]) over the genes
+ *
+ * The terms are computed a vector at a time and added in the order of the
+ * scalar loops, so that only the error of the math differs from them.
+ *
+ * \param x    : The genes
+ * \param n    : Number of genes
+ * \param term : Functor, V(V) for both Vec and Scalar
+ */
+
+template <class Term>
+inline double sum_of(const double* x, const std::size_t n, const Term& term) {
+  double sum = 0.0, terms[Vec::width];
+  std::size_t i = 0;
+  for (; i + Vec::width <= n; i += Vec::width) {
+    term(Vec::load(x + i)).store(terms);
+    for (std::size_t k = 0; k < Vec::width; ++k)
+      sum += terms[k];
+  }
+  for (; i < n; ++i)
+    sum += term(Scalar(x[i])).v;
+  return sum;
+}
+
+struct RastriginTerm {
+  template <class V>
+  V operator()(const V x) const {
+    return x * x - V(10.0) * cosine(V(2 * M_PI) * x) + V(10.0);
+  }
+};
+
+struct Cos2PiTerm {
+  template <class V>
+  V operator()(const V x) const {
+    return cosine(V(2 * M_PI) * x);
+  }
+};
+
+struct LevyTerm {
+  template <class V>
+  V operator()(const V x) const {
+    const V w = V(1.0) + (x - V(1.0)) * V(0.25);
+    const V s = sine(V(M_PI) * w + V(1.0));
+    return (w - V(1.0)) * (w - V(1.0)) * (V(1.0) + V(10.0) * (s * s));
+  }
+};
+
+struct SchwefelTerm {
+  double D; /*!< Number of genes */
+
+  template <class V>
+  V operator()(const V x) const {
+    const V z = x + V(4.209687462275036e+002), a = abs(z);
+    const V outside = a > V(500.0);
+    // fmod(|z|, 500); exact, as |z| - 500 k is exact for the nearest k
+    V m = a - V(500.0) * round_nearest(a / V(500.0));
+    m = select(m < V(0.0), m + V(500.0), m);
+    // Outside [-500, 500] fold z back and penalize the excess
+    const V u = select(outside, V(500.0) - m, a);
+    const V excess = (a - V(500.0)) / V(100.0);
+    const V penalty = select(outside, excess * excess / V(D), V(0.0));
+    return copysign(u, z) * sine(sqrt(u)) - penalty;
+  }
+};
+
+struct GriewankRosenbrockTerm {
+  template <class V>
+  V operator()(const V x, const V next) const {
+    const V t = (x + V(1.0)) * (x + V(1.0)) - (next + V(1.0));
+    const V r = V(100.0) * t * t + x * x;
+    return (r * r) / V(4000.0) - cosine(r) + V(1.0);
+  }
+};
+
+/*! Kernels, \see Kernels */
+
+inline void sin(const double* x, double* y, const std::size_t n) {
+  std::size_t i = 0;
+  for (; i + Vec::width <= n; i += Vec::width)
+    sine(Vec::load(x + i)).store(y + i);
+  for (; i < n; ++i)
+    y[i] = sine(Scalar(x[i])).v;
+}
+
+inline void cos(const double* x, double* y, const std::size_t n) {
+  std::size_t i = 0;
+  for (; i + Vec::width <= n; i += Vec::width)
+    cosine(Vec::load(x + i)).store(y + i);
+  for (; i < n; ++i)
+    y[i] = cosine(Scalar(x[i])).v;
+}
+
+inline double rastrigin(const double* x, const std::size_t n) {
+  return sum_of(x, n, RastriginTerm());
+}
+
+inline double sum_cos_2pi(const double* x, const std::size_t n) {
+  return sum_of(x, n, Cos2PiTerm());
+}
+
+inline void ackley_sums(const double* x, const std::size_t n, double* sums) {
+  double squares = 0.0, cosines = 0.0, terms[Vec::width];
+  std::size_t i = 0;
+  for (; i + Vec::width <= n; i += Vec::width) {
+    const Vec x_i = Vec::load(x + i);
+    cosine(Vec(2 * M_PI) * x_i).store(terms);
+    for (std::size_t k = 0; k < Vec::width; ++k) {
+      squares += x[i + k] * x[i + k];
+      cosines += terms[k];
+    }
+  }
+  for (; i < n; ++i) {
+    squares += x[i] * x[i];
+    cosines += cosine(Scalar(2 * M_PI * x[i])).v;
+  }
+  sums[0] = squares;
+  sums[1] = cosines;
+}
+
+inline double griewank(const double* x, const std::size_t n) {
+  const double offsets[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  const Vec lane_offsets = Vec::load(offsets);
+  double sum = 0.0, product = 1.0, terms[Vec::width];
+  std::size_t i = 0;
+  for (; i + Vec::width <= n; i += Vec::width) {
+    const Vec x_i = Vec::load(x + i);
+    cosine(x_i / sqrt(Vec(double(i)) + lane_offsets)).store(terms);
+    for (std::size_t k = 0; k < Vec::width; ++k) {
+      sum += x[i + k] * x[i + k];
+      product *= terms[k];
+    }
+  }
+  for (; i < n; ++i) {
+    sum += x[i] * x[i];
+    product *= cosine(Scalar(x[i]) / sqrt(Scalar(i + 1.0))).v;
+  }
+  return 1 + sum / 4000 - product;
+}
+
+inline double schwefel(const double* x, const std::size_t n) {
+  const SchwefelTerm term{double(n)};
+  double sum = 0.0, terms[Vec::width];
+  std::size_t i = 0;
+  for (; i + Vec::width <= n; i += Vec::width) {
+    term(Vec::load(x + i)).store(terms);
+    for (std::size_t k = 0; k < Vec::width; ++k)
+      sum -= terms[k];
+  }
+  for (; i < n; ++i)
+    sum -= term(Scalar(x[i])).v;
+  return sum + 4.189828872724338e+002 * n;
+}
+
+inline double levy(const double* x, const std::size_t n) {
+  const double w_0 = 1.0 + (x[0] - 1.0) / 4.0,
+               w_n = 1.0 + (x[n - 1] - 1.0) / 4.0;
+  const double s_0 = sine(Scalar(M_PI * w_0)).v,
+               s_n = sine(Scalar(2 * M_PI * w_n)).v;
+  return s_0 * s_0 + sum_of(x, n - 1, LevyTerm()) +
+         (w_n - 1) * (w_n - 1) * (1 + s_n * s_n);
+}
+
+inline double griewank_rosenbrock(const double* x, const std::size_t n) {
+  const GriewankRosenbrockTerm term;
+  double sum = 0.0, terms[Vec::width];
+  std::size_t i = 0;
+  for (; i + Vec::width < n; i += Vec::width) {
+    term(Vec::load(x + i), Vec::load(x + i + 1)).store(terms);
+    for (std::size_t k = 0; k < Vec::width; ++k)
+      sum += terms[k];
+  }
+  for (; i + 1 < n; ++i)
+    sum += term(Scalar(x[i]), Scalar(x[i + 1])).v;
+  return sum + term(Scalar(x[n - 1]), Scalar(x[0])).v;
+}
+
+/*!
+ * \brief y[i..i + K V::width) of the transform, \see transform
+ *
+ * The K vectors of outputs stay in registers while the rows of the rotation
+ * stream past; every output adds its products in the order j = 0, 1, ...
+ */
+
+template <class V, std::size_t K, class T>
+inline void transform_block(const T* x, const T* shift, const T scale,
+                            const T* rotation, const std::size_t stride,
+                            const std::size_t n, T* y) {
+  V sums[K];
+  for (std::size_t k = 0; k < K; ++k)
+    sums[k] = V(0.0);
+  for (std::size_t j = 0; j < n; ++j) {
+    const V x_j((shift ? x[j] - shift[j] : x[j]) * scale);
+    const T* row = rotation + j * stride;
+    for (std::size_t k = 0; k < K; ++k)
+      sums[k] = sums[k] + x_j * V::load(row + k * V::width);
+  }
+  for (std::size_t k = 0; k < K; ++k)
+    sums[k].store(y + k * V::width);
+}
+
+template <class T>
+inline void transform(const T* x, const T* shift, const T scale,
+                      const T* rotation, const std::size_t stride,
+                      const std::size_t n, T* y) {
+  using V = typename Lanes<T>::Wide;
+  constexpr std::size_t block = 4 * V::width;
+  std::size_t i = 0;
+  for (; i + block <= n; i += block)
+    transform_block<V, 4>(x, shift, scale, rotation + i, stride, n, y + i);
+  for (; i + V::width <= n; i += V::width)
+    transform_block<V, 1>(x, shift, scale, rotation + i, stride, n, y + i);
+  for (; i < n; ++i)
+    transform_block<typename Lanes<T>::Narrow, 1>(x, shift, scale,
+                                                  rotation + i, stride, n,
+                                                  y + i);
+}
+
+/*!
+ * \brief A tile of R rows by K vectors of the batched product
+ *
+ * Each rotation load is shared by the R rows and each gene by the K vectors,
+ * so the R K sums stay in registers; every output still adds its products
+ * in the order j = 0, 1, ...
+ */
+
+template <class V, std::size_t R, std::size_t K, class T>
+inline void rotate_tile(const T* x, const std::size_t x_stride,
+                        const T* rotation, const std::size_t stride,
+                        const std::size_t n, T* y,
+                        const std::size_t y_stride) {
+  V sums[R][K];
+  for (std::size_t r = 0; r < R; ++r)
+    for (std::size_t k = 0; k < K; ++k)
+      sums[r][k] = V(0.0);
+  for (std::size_t j = 0; j < n; ++j) {
+    const T* row = rotation + j * stride;
+    V m[K];
+    for (std::size_t k = 0; k < K; ++k)
+      m[k] = V::load(row + k * V::width);
+    for (std::size_t r = 0; r < R; ++r) {
+      const V x_j(x[r * x_stride + j]);
+      for (std::size_t k = 0; k < K; ++k)
+        sums[r][k] = sums[r][k] + x_j * m[k];
+    }
+  }
+  for (std::size_t r = 0; r < R; ++r)
+    for (std::size_t k = 0; k < K; ++k)
+      sums[r][k].store(y + r * y_stride + k * V::width);
+}
+
+/*! The rows of the batched product for one column tile */
+template <class V, std::size_t K, class T>
+inline void rotate_columns(const T* x, const std::size_t x_stride,
+                           const std::size_t rows, const T* rotation,
+                           const std::size_t stride, const std::size_t n,
+                           T* y, const std::size_t y_stride) {
+  constexpr std::size_t R = 4;
+  std::size_t r = 0;
+  for (; r + R <= rows; r += R)
+    rotate_tile<V, R, K>(x + r * x_stride, x_stride, rotation, stride, n,
+                         y + r * y_stride, y_stride);
+  for (; r < rows; ++r)
+    rotate_tile<V, 1, K>(x + r * x_stride, x_stride, rotation, stride, n,
+                         y + r * y_stride, y_stride);
+}
+
+template <class T>
+inline void rotate_batch(const T* x, const std::size_t x_stride,
+                         const std::size_t rows, const T* rotation,
+                         const std::size_t stride, const std::size_t n, T* y,
+                         const std::size_t y_stride) {
+  // A column tile of the rotation (n rows of 2 vectors) stays in L1 while
+  // all the rows of the batch pass over it. The padding columns of the
+  // rotation are zero, so whole vectors run past n.
+  using V = typename Lanes<T>::Wide;
+  const std::size_t cols = (n + V::width - 1) / V::width * V::width;
+  constexpr std::size_t block = 2 * V::width;
+  std::size_t i = 0;
+  for (; i + block <= cols; i += block)
+    rotate_columns<V, 2>(x, x_stride, rows, rotation + i, stride, n, y + i,
+                         y_stride);
+  for (; i < cols; i += V::width)
+    rotate_columns<V, 1>(x, x_stride, rows, rotation + i, stride, n, y + i,
+                         y_stride);
+}
+
+/*!
+ * \brief x[i] = op(x[i], parent[i], lower[i], upper[i]) for every gene
+ *
+ * \param parent : May be null if op ignores it
+ * \param op     : Functor, V(V, V, V, V) for both Vec and Scalar
+ */
+
+template <class T, class Op>
+inline void for_each_gene(T* x, const T* parent, const T* lower,
+                          const T* upper, const std::size_t n, const Op& op) {
+  using V = typename Lanes<T>::Wide;
+  using S = typename Lanes<T>::Narrow;
+  std::size_t i = 0;
+  for (; i + V::width <= n; i += V::width)
+    op(V::load(x + i), parent ? V::load(parent + i) : V(T(0)),
+       V::load(lower + i), V::load(upper + i))
+        .store(x + i);
+  for (; i < n; ++i)
+    x[i] = op(S(x[i]), S(parent ? parent[i] : T(0)), S(lower[i]),
+              S(upper[i]))
+               .v;
+}
+
+struct ScaleToBounds {
+  template <class V>
+  V operator()(const V x, const V, const V lower, const V upper) const {
+    return lower + x * (upper - lower);
+  }
+};
+
+/*! std::max(lower, std::min(x, upper)), NaN included */
+struct Clip {
+  template <class V>
+  V operator()(const V x, const V, const V lower, const V upper) const {
+    const V m = select(upper < x, upper, x);
+    return select(lower < m, m, lower);
+  }
+};
+
+struct Reflect {
+  template <class V>
+  V operator()(const V x, const V, const V lower, const V upper) const {
+    const V y = select(x < lower, V(2.0) * lower - x,
+                       select(x > upper, V(2.0) * upper - x, x));
+    return Clip()(y, y, lower, upper);
+  }
+};
+
+struct Midpoint {
+  template <class V>
+  V operator()(const V x, const V parent, const V lower, const V upper) const {
+    return select(x < lower, (lower + parent) / V(2.0),
+                  select(x > upper, (upper + parent) / V(2.0), x));
+  }
+};
+
+template <class T>
+inline bool outside(const T* x, const T* lower, const T* upper,
+                    const std::size_t n) {
+  using V = typename Lanes<T>::Wide;
+  std::size_t i = 0;
+  for (; i + V::width <= n; i += V::width) {
+    const V v = V::load(x + i);
+    if (!all((V::load(lower + i) <= v) & (v <= V::load(upper + i))))
+      return true;
+  }
+  for (; i < n; ++i)
+    if (!(lower[i] <= x[i] && x[i] <= upper[i]))
+      return true;
+  return false;
+}
+
+template <class T>
+inline void scale_to_bounds(T* x, const T* lower, const T* upper,
+                            const std::size_t n) {
+  for_each_gene<T>(x, nullptr, lower, upper, n, ScaleToBounds());
+}
+
+template <class T>
+inline void clip(T* x, const T* lower, const T* upper, const std::size_t n) {
+  for_each_gene<T>(x, nullptr, lower, upper, n, Clip());
+}
+
+template <class T>
+inline void reflect(T* x, const T* lower, const T* upper,
+                    const std::size_t n) {
+  for_each_gene<T>(x, nullptr, lower, upper, n, Reflect());
+}
+
+template <class T>
+inline void midpoint(T* x, const T* parent, const T* lower, const T* upper,
+                     const std::size_t n) {
+  for_each_gene<T>(x, parent, lower, upper, n, Midpoint());
+}
@@ -0,0 +1,186 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief A single double (or float) with the interface of the SIMD vectors
+ *
+ * The kernels of simd/kernels.hpp are written once for any vector type V.
+ * Scalar is the vector of width one: it handles the remainders of the
+ * vectorized loops and is the portable implementation of the kernels.
+ * ScalarF is the same on floats, for the kernels that have float versions.
+ *
+ * Masks are vectors whose lanes are either all ones or all zeros.
+ */
+
+#ifndef DE_SIMD_SCALAR_HPP
+#define DE_SIMD_SCALAR_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace DE {
+namespace SIMD {
+
+/*!
+ * \struct Scalar
+ * \brief A vector of a single double
+ */
+
+struct Scalar {
+  static constexpr std::size_t width = 1; /*!< Number of lanes */
+  double v;                               /*!< The value */
+
+  Scalar() = default;
+  Scalar(const double x) : v(x) {}
+  static Scalar load(const double* p) { return *p; }
+  void store(double* p) const { *p = v; }
+};
+
+namespace detail {
+
+inline std::uint64_t to_bits(const double x) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+inline double from_bits(const std::uint64_t bits) {
+  double x;
+  std::memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+inline Scalar mask(const bool condition) {
+  return from_bits(condition ? ~std::uint64_t(0) : 0);
+}
+
+}  // namespace detail
+
+inline Scalar operator+(const Scalar a, const Scalar b) { return a.v + b.v; }
+inline Scalar operator-(const Scalar a, const Scalar b) { return a.v - b.v; }
+inline Scalar operator*(const Scalar a, const Scalar b) { return a.v * b.v; }
+inline Scalar operator/(const Scalar a, const Scalar b) { return a.v / b.v; }
+
+inline Scalar operator&(const Scalar a, const Scalar b) {
+  return detail::from_bits(detail::to_bits(a.v) & detail::to_bits(b.v));
+}
+
+inline Scalar operator|(const Scalar a, const Scalar b) {
+  return detail::from_bits(detail::to_bits(a.v) | detail::to_bits(b.v));
+}
+
+inline Scalar operator^(const Scalar a, const Scalar b) {
+  return detail::from_bits(detail::to_bits(a.v) ^ detail::to_bits(b.v));
+}
+
+/*! \brief ~a & b, bitwise */
+inline Scalar andnot(const Scalar a, const Scalar b) {
+  return detail::from_bits(~detail::to_bits(a.v) & detail::to_bits(b.v));
+}
+
+inline Scalar operator<(const Scalar a, const Scalar b) {
+  return detail::mask(a.v < b.v);
+}
+
+inline Scalar operator<=(const Scalar a, const Scalar b) {
+  return detail::mask(a.v <= b.v);
+}
+
+inline Scalar operator>(const Scalar a, const Scalar b) {
+  return detail::mask(a.v > b.v);
+}
+
+/*! \brief a * b + c; fused only where the instruction set has FMA */
+inline Scalar fma(const Scalar a, const Scalar b, const Scalar c) {
+  return a.v * b.v + c.v;
+}
+
+inline Scalar sqrt(const Scalar a) { return std::sqrt(a.v); }
+inline Scalar abs(const Scalar a) { return std::fabs(a.v); }
+
+/*! \brief Lanes of \p a where \p mask is set, of \p b elsewhere */
+inline Scalar select(const Scalar mask, const Scalar a, const Scalar b) {
+  return detail::to_bits(mask.v) ? a : b;
+}
+
+/*! \brief Mask of the lanes whose bit \p bit (< 32) is set */
+inline Scalar test_bit(const Scalar a, const int bit) {
+  return detail::mask((detail::to_bits(a.v) >> bit) & 1);
+}
+
+/*! \brief True if \p mask is set in every lane */
+inline bool all(const Scalar mask) {
+  return detail::to_bits(mask.v) != 0;
+}
+
+inline double reduce_add(const Scalar a) { return a.v; }
+inline double reduce_mul(const Scalar a) { return a.v; }
+
+/*!
+ * \struct ScalarF
+ * \brief A vector of a single float
+ */
+
+struct ScalarF {
+  static constexpr std::size_t width = 1; /*!< Number of lanes */
+  float v;                                /*!< The value */
+
+  ScalarF() = default;
+  ScalarF(const float x) : v(x) {}
+  static ScalarF load(const float* p) { return *p; }
+  void store(float* p) const { *p = v; }
+};
+
+namespace detail {
+
+inline std::uint32_t to_bits(const float x) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+inline float from_bits(const std::uint32_t bits) {
+  float x;
+  std::memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+inline ScalarF mask_f(const bool condition) {
+  return from_bits(condition ? ~std::uint32_t(0) : std::uint32_t(0));
+}
+
+}  // namespace detail
+
+inline ScalarF operator+(const ScalarF a, const ScalarF b) { return a.v + b.v; }
+inline ScalarF operator-(const ScalarF a, const ScalarF b) { return a.v - b.v; }
+inline ScalarF operator*(const ScalarF a, const ScalarF b) { return a.v * b.v; }
+inline ScalarF operator/(const ScalarF a, const ScalarF b) { return a.v / b.v; }
+
+inline ScalarF operator&(const ScalarF a, const ScalarF b) {
+  return detail::from_bits(detail::to_bits(a.v) & detail::to_bits(b.v));
+}
+
+inline ScalarF operator<(const ScalarF a, const ScalarF b) {
+  return detail::mask_f(a.v < b.v);
+}
+
+inline ScalarF operator<=(const ScalarF a, const ScalarF b) {
+  return detail::mask_f(a.v <= b.v);
+}
+
+inline ScalarF operator>(const ScalarF a, const ScalarF b) {
+  return detail::mask_f(a.v > b.v);
+}
+
+inline ScalarF select(const ScalarF mask, const ScalarF a, const ScalarF b) {
+  return detail::to_bits(mask.v) ? a : b;
+}
+
+inline bool all(const ScalarF mask) { return detail::to_bits(mask.v) != 0; }
+
+}  // namespace SIMD
+}  // namespace DE
+#endif  // DE_SIMD_SCALAR_HPP
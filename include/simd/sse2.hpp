@@ -0,0 +1,137 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief Vectors of two doubles and of four floats on SSE2
+ *
+ * Included by simd.hpp inside namespace DE::SIMD::sse2. SSE2 is part of
+ * x86-64, hence no target has to be enabled.
+ */
+
+#ifndef DE_SIMD_SSE2_HPP
+#define DE_SIMD_SSE2_HPP
+
+/*!
+ * \struct Vec
+ * \brief A vector of two doubles
+ */
+
+struct Vec {
+  static constexpr std::size_t width = 2; /*!< Number of lanes */
+  __m128d v;                              /*!< The lanes */
+
+  Vec() = default;
+  Vec(const __m128d x) : v(x) {}
+  Vec(const double x) : v(_mm_set1_pd(x)) {}
+  static Vec load(const double* p) { return _mm_loadu_pd(p); }
+  void store(double* p) const { _mm_storeu_pd(p, v); }
+};
+
+inline Vec operator+(const Vec a, const Vec b) { return _mm_add_pd(a.v, b.v); }
+inline Vec operator-(const Vec a, const Vec b) { return _mm_sub_pd(a.v, b.v); }
+inline Vec operator*(const Vec a, const Vec b) { return _mm_mul_pd(a.v, b.v); }
+inline Vec operator/(const Vec a, const Vec b) { return _mm_div_pd(a.v, b.v); }
+inline Vec operator&(const Vec a, const Vec b) { return _mm_and_pd(a.v, b.v); }
+inline Vec operator|(const Vec a, const Vec b) { return _mm_or_pd(a.v, b.v); }
+inline Vec operator^(const Vec a, const Vec b) { return _mm_xor_pd(a.v, b.v); }
+inline Vec andnot(const Vec a, const Vec b) { return _mm_andnot_pd(a.v, b.v); }
+
+inline Vec operator<(const Vec a, const Vec b) {
+  return _mm_cmplt_pd(a.v, b.v);
+}
+
+inline Vec operator<=(const Vec a, const Vec b) {
+  return _mm_cmple_pd(a.v, b.v);
+}
+
+inline Vec operator>(const Vec a, const Vec b) {
+  return _mm_cmpgt_pd(a.v, b.v);
+}
+
+inline Vec fma(const Vec a, const Vec b, const Vec c) { return a * b + c; }
+inline Vec sqrt(const Vec a) { return _mm_sqrt_pd(a.v); }
+inline Vec abs(const Vec a) { return andnot(Vec(-0.0), a); }
+
+inline Vec select(const Vec mask, const Vec a, const Vec b) {
+  return (mask & a) | andnot(mask, b);
+}
+
+inline Vec test_bit(const Vec a, const int bit) {
+  // SSE2 cannot compare 64-bit integers; the bit lies in the low half of each
+  // lane, whose comparison is copied to the high half
+  const __m128i b = _mm_set1_epi64x(std::int64_t(1) << bit);
+  const __m128i equal =
+      _mm_cmpeq_epi32(_mm_and_si128(_mm_castpd_si128(a.v), b), b);
+  return _mm_castsi128_pd(_mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 2, 0, 0)));
+}
+
+inline bool all(const Vec mask) { return _mm_movemask_pd(mask.v) == 0x3; }
+
+inline double reduce_add(const Vec a) {
+  double lanes[Vec::width];
+  a.store(lanes);
+  return lanes[0] + lanes[1];
+}
+
+inline double reduce_mul(const Vec a) {
+  double lanes[Vec::width];
+  a.store(lanes);
+  return lanes[0] * lanes[1];
+}
+
+/*!
+ * \struct VecF
+ * \brief A vector of four floats
+ */
+
+struct VecF {
+  static constexpr std::size_t width = 4; /*!< Number of lanes */
+  __m128 v;                               /*!< The lanes */
+
+  VecF() = default;
+  VecF(const __m128 x) : v(x) {}
+  VecF(const float x) : v(_mm_set1_ps(x)) {}
+  static VecF load(const float* p) { return _mm_loadu_ps(p); }
+  void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+
+inline VecF operator+(const VecF a, const VecF b) {
+  return _mm_add_ps(a.v, b.v);
+}
+
+inline VecF operator-(const VecF a, const VecF b) {
+  return _mm_sub_ps(a.v, b.v);
+}
+
+inline VecF operator*(const VecF a, const VecF b) {
+  return _mm_mul_ps(a.v, b.v);
+}
+
+inline VecF operator/(const VecF a, const VecF b) {
+  return _mm_div_ps(a.v, b.v);
+}
+
+inline VecF operator&(const VecF a, const VecF b) {
+  return _mm_and_ps(a.v, b.v);
+}
+
+inline VecF operator<(const VecF a, const VecF b) {
+  return _mm_cmplt_ps(a.v, b.v);
+}
+
+inline VecF operator<=(const VecF a, const VecF b) {
+  return _mm_cmple_ps(a.v, b.v);
+}
+
+inline VecF operator>(const VecF a, const VecF b) {
+  return _mm_cmpgt_ps(a.v, b.v);
+}
+
+inline VecF select(const VecF mask, const VecF a, const VecF b) {
+  return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v));
+}
+
+inline bool all(const VecF mask) { return _mm_movemask_ps(mask.v) == 0xf; }
+
+#endif  // DE_SIMD_SSE2_HPP
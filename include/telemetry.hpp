@@ -0,0 +1,207 @@
+/*!
+ * \file
+ * \author Nikos Tsakiridis <tsakirin@auth.gr>
+ * \version 1.0
+ *
+ * \brief The state of the algorithms after every generation
+ *
+ * An optimizer given a GenerationObserver (\see Base::set_observer) hands it
+ * a GenerationRecord at the end of every generation, from the thread that
+ * runs evolve_population. Without an observer nothing is computed. The
+ * AsyncObserver only copies the record into a RingBuffer, and leaves it to a
+ * thread of its own to pass the records on to a sink (a CsvWriter for
+ * instance), so that slow sinks do not slow down the generations.
+ */
+
+#ifndef DE_TELEMETRY_HPP
+#define DE_TELEMETRY_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include "ring_buffer.hpp"
+
+namespace DE {
+
+/*!
+ * \struct GenerationRecord
+ * \brief The state of an optimizer after a generation
+ */
+
+struct GenerationRecord {
+  /*! Memory values recorded at most (SHADE keeps 6) */
+  static constexpr std::size_t max_memory_size = 8;
+
+  std::size_t run = 0;             /*!< Index of the run */
+  std::size_t generation = 0;      /*!< Generations evolved so far */
+  std::size_t evaluations = 0;     /*!< Evaluations of the fitness so far */
+  std::size_t population_size = 0; /*!< Current number of chromosomes */
+  std::size_t successes = 0;       /*!< Trials strictly better than parents */
+  std::size_t archive_size = 0;    /*!< Chromosomes in the archive */
+  std::size_t archive_capacity = 0; /*!< Maximum size of the archive */
+  std::size_t memory_size = 0;     /*!< Memory values recorded below */
+  double best_fitness = 0.0;       /*!< Fitness of the best chromosome */
+  double mean_fitness = 0.0;       /*!< Mean fitness of the population */
+  /*! Root mean square distance of the chromosomes from their centroid */
+  double diversity = 0.0;
+  double elapsed_seconds = 0.0;    /*!< Since the optimizer was created */
+  /*! Scale factor memory (SHADE's M_F) */
+  std::array<float, max_memory_size> memory_F{};
+  /*! Crossover memory (SHADE's M_Cr), TERMINAL_VALUE once terminal */
+  std::array<float, max_memory_size> memory_Cr{};
+};
+
+/*!
+ * \class GenerationObserver
+ * \brief Receives a record at the end of every generation
+ *
+ * on_generation runs within evolve_population, hence it should return
+ * quickly. An observer shared by optimizers running on several threads is
+ * called from all of them.
+ */
+
+class GenerationObserver {
+ public:
+  virtual ~GenerationObserver() = default;
+
+  /*! \brief Called after every generation */
+  virtual void on_generation(const GenerationRecord& record) = 0;
+};
+
+/*!
+ * \class AsyncObserver
+ * \brief Queues the records, and passes them on to a sink from a thread of
+ *        its own
+ *
+ * on_generation neither locks nor allocates. If the sink falls so far
+ * behind that the buffer fills up, the records that do not fit are dropped
+ * and counted, rather than wait for it. The records still queued are passed
+ * on when the observer is destroyed.
+ */
+
+class AsyncObserver : public GenerationObserver {
+ public:
+  /*! Receives the records, in the order they were queued */
+  using Sink = std::function<void(const GenerationRecord&)>;
+
+  /*!
+   * \brief Start the thread that drains the buffer
+   *
+   * \param sink     : Receives the records; only ever called from the
+   *                   thread of the observer
+   * \param capacity : Records queued at most, a power of two
+   * \param period   : The buffer is drained at least this often
+   */
+
+  explicit AsyncObserver(
+      Sink sink,
+      const std::size_t capacity = 1024,
+      const std::chrono::milliseconds period = std::chrono::milliseconds(10))
+      : sink_(std::move(sink)),
+        buffer_(capacity),
+        period_(period),
+        thread_([this] { drain_until_stopped(); }) {}
+
+  AsyncObserver(const AsyncObserver&) = delete;
+  AsyncObserver& operator=(const AsyncObserver&) = delete;
+
+  /*! Pass on the records still queued, and join the thread */
+  ~AsyncObserver() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+  }
+
+  void on_generation(const GenerationRecord& record) override {
+    if (!buffer_.push(record))
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /*! Number of records dropped because the buffer was full */
+  std::size_t dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const Sink sink_;
+  RingBuffer<GenerationRecord> buffer_;
+  const std::chrono::milliseconds period_;
+  std::atomic<std::size_t> dropped_{0};
+  /*! Only for stopping the thread; on_generation does not touch them */
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+  std::thread thread_;  // Last, it uses all of the above
+
+  void drain() {
+    GenerationRecord record;
+    while (buffer_.pop(record))
+      sink_(record);
+  }
+
+  void drain_until_stopped() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+      lock.unlock();
+      drain();
+      lock.lock();
+      wake_.wait_for(lock, period_, [this] { return stop_; });
+    }
+    lock.unlock();
+    drain();
+  }
+};
+
+/*!
+ * \class CsvWriter
+ * \brief A sink writing one line of comma separated values per record
+ *
+ * The header is written at construction. The memories are written as one
+ * column each, with their values separated by semicolons. Every line is
+ * flushed, so that the file can be followed while the optimizer runs.
+ */
+
+class CsvWriter {
+ public:
+  /*! \brief Write the header to \p out, which must outlive the writer */
+  explicit CsvWriter(std::ostream& out) : out_(&out) {
+    *out_ << "run,generation,evaluations,population_size,successes,"
+             "archive_size,archive_capacity,best_fitness,mean_fitness,"
+             "diversity,elapsed_seconds,memory_F,memory_Cr"
+          << std::endl;
+  }
+
+  void operator()(const GenerationRecord& r) const {
+    *out_ << r.run << ',' << r.generation << ',' << r.evaluations << ','
+          << r.population_size << ',' << r.successes << ',' << r.archive_size
+          << ',' << r.archive_capacity << ',' << r.best_fitness << ','
+          << r.mean_fitness << ',' << r.diversity << ',' << r.elapsed_seconds
+          << ',';
+    write_memory(r.memory_F, r.memory_size);
+    *out_ << ',';
+    write_memory(r.memory_Cr, r.memory_size);
+    *out_ << std::endl;
+  }
+
+ private:
+  std::ostream* out_;
+
+  void write_memory(
+      const std::array<float, GenerationRecord::max_memory_size>& memory,
+      const std::size_t size) const {
+    for (std::size_t k = 0; k < size; ++k)
+      *out_ << (k ? ";" : "") << memory[k];
+  }
+};
+
+}  // namespace DE
+#endif  // DE_TELEMETRY_HPP
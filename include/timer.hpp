@@ -6,16 +6,29 @@
  * \brief Simple implementation for a timer function
  */
 
+#ifndef DE_TIMER_HPP
+#define DE_TIMER_HPP
+
 #include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+/*! Defined where TscClock is available */
+#define DE_HAS_TSC
+#endif
 
 /*!
- * \struct Timer
- * \brief A simple wrapper around chrono to record the time
+ * \struct BasicTimer
+ * \brief A simple wrapper around a chrono clock to record the time
+ *
+ * \tparam Clock : A clock meeting the requirements of the chrono clocks
  */
 
-struct Timer {
+template <class Clock>
+struct BasicTimer {
   /*! The clock to be used */
-  using clock = std::chrono::high_resolution_clock;
+  using clock = Clock;
 
   /*! Count time elapsed */
   template <class DurationType = std::chrono::nanoseconds>
@@ -28,5 +41,62 @@ struct Timer {
 
  private:
   /*! Clock starts ticking at construction time */
-  std::chrono::time_point<clock> start_ = clock::now();
+  typename clock::time_point start_ = clock::now();
 };
+
+/*! The timer of the library, on the high resolution clock */
+using Timer = BasicTimer<std::chrono::high_resolution_clock>;
+
+#ifdef DE_HAS_TSC
+
+/*!
+ * \struct TscClock
+ * \brief A chrono clock reading the time stamp counter of the processor
+ *
+ * Reading the counter takes a few nanoseconds, less than the system clocks
+ * (much less where they are not served without a system call, as on some
+ * virtual machines). Its rate is measured against the steady clock once,
+ * over 10 ms on the first call of now(). The counter must tick at a
+ * constant rate, alike on all the cores, which is the case on the x86
+ * processors of the last decade ("constant_tsc" and "nonstop_tsc" in
+ * /proc/cpuinfo).
+ */
+
+struct TscClock {
+  using rep = std::int64_t;
+  using period = std::nano;
+  using duration = std::chrono::duration<rep, period>;
+  using time_point = std::chrono::time_point<TscClock>;
+  static constexpr bool is_steady = true;
+
+  /*! Nanoseconds since the calibration */
+  static time_point now() noexcept {
+    static const Calibration calibration = calibrate();
+    return time_point(duration(
+        rep(std::int64_t(__rdtsc() - calibration.ticks) *
+            calibration.nanoseconds_per_tick)));
+  }
+
+ private:
+  struct Calibration {
+    std::uint64_t ticks;         /*!< The counter at the calibration */
+    double nanoseconds_per_tick; /*!< Inverse rate of the counter */
+  };
+
+  static Calibration calibrate() {
+    using steady = std::chrono::steady_clock;
+    const auto start = steady::now();
+    const std::uint64_t start_ticks = __rdtsc();
+    auto end = start;
+    while (end - start < std::chrono::milliseconds(10))
+      end = steady::now();
+    const std::uint64_t end_ticks = __rdtsc();
+    return {end_ticks,
+            std::chrono::duration<double, std::nano>(end - start).count() /
+                double(end_ticks - start_ticks)};
+  }
+};
+
+#endif  // DE_HAS_TSC
+
+#endif  // DE_TIMER_HPP
@@ -1,5 +1,9 @@
 #include "algorithm/degl.hpp"
+#include <algorithm>
+#include <assert.h>
 #include "algorithm/differential_evolution.hpp"
+#include "dimension.hpp"
+#include "profiler.hpp"
 #include "rand.hpp"
 
 namespace DE {
@@ -14,127 +18,149 @@ constexpr float DEGL<T>::Cr;
 template <class T>
 DEGL<T>::DEGL(std::shared_ptr<Problem::Base<T>> problem,
               const std::vector<T>& initial_chromosome,
-              const bool minimize)
+              const bool minimize,
+              std::shared_ptr<Executor> executor,
+              const std::size_t run)
     : Base<T>(problem,
               initial_chromosome,
               10 * problem->get_number_of_genes(),
-              minimize),
+              minimize,
+              executor,
+              run),
       k_(Base<T>::N_ <= 10 ? 1 : (Base<T>::N_ / 10) + 1) {
   initialize_weights();
 }
 
 template <class T>
-DEGL<T>::DEGL(std::shared_ptr<Problem::Base<T>> problem, const bool minimize)
-    : Base<T>(problem, 10 * problem->get_number_of_genes(), minimize),
+DEGL<T>::DEGL(std::shared_ptr<Problem::Base<T>> problem,
+              const bool minimize,
+              std::shared_ptr<Executor> executor,
+              const std::size_t run)
+    : Base<T>(problem,
+              10 * problem->get_number_of_genes(),
+              minimize,
+              executor,
+              run),
       k_(Base<T>::N_ <= 10 ? 1 : (Base<T>::N_ / 10) + 1) {
   initialize_weights();
 }
 
 template <class T>
 void DEGL<T>::evolve_population(const std::size_t max_generations) {
-#ifdef CEC_MAX_EVALUATIONS
-  const std::size_t max_evaluations = Base<T>::D_ * 10e4;
-  std::size_t evaluations = 0;
-#endif
   for (std::size_t g = 0; g < max_generations; ++g) {
-    std::size_t best_index = Base<T>::best_index();
-    for (std::size_t i = 0; i < Base<T>::N_; ++i) {
-      auto u = mutate(i, best_index);
-      auto v = binary_crossover(Base<T>::x_[i], u, Cr);
-      auto trial_fitness = Base<T>::p_problem_->fitness(v);
-      if (Base<T>::compare_fitnesses_with_equality(Base<T>::fit_[i],
-                                                   trial_fitness)) {
-        std::swap(Base<T>::x_[i], v);
-        Base<T>::fit_[i] = trial_fitness;
-        w_[i] = w_mutated_[i];
+    const std::size_t trials = Base<T>::trials_within_limit(Base<T>::N_);
+    if (trials == 0)
+      break;
+    const std::size_t best_index = Base<T>::best_index();
+    draw_parameters();
+    // DEGL is synchronous: all trials are built from the same generation
+    Base<T>::executor_->parallel_for(
+        trials,
+        [this, best_index](const std::size_t begin, const std::size_t end) {
+          generate_trials(begin, end, best_index);
+        });
+    std::size_t successes = 0;
+    {
+      DE_PROFILE_PHASE(selection);
+      for (std::size_t i = 0; i < trials; ++i) {
+        if (Base<T>::compare_fitnesses_with_equality(
+                Base<T>::fit_[i], Base<T>::trial_fit_[i])) {
+          successes += Base<T>::fit_[i] != Base<T>::trial_fit_[i];
+          const auto v = Base<T>::trials_[i];
+          std::copy(v.begin(), v.end(), Base<T>::x_[i].begin());
+          Base<T>::fit_[i] = Base<T>::trial_fit_[i];
+          w_[i] = w_mutated_[i];
+        }
       }
     }
-#ifdef CEC_MAX_EVALUATIONS
-    evaluations += Base<T>::N_;
-    if (evaluations > max_evaluations)
-      break;
-#endif
+    Base<T>::evaluations_ += trials;
+    ++Base<T>::generation_;
+    if (Base<T>::observer_)
+      Base<T>::observer_->on_generation(
+          Base<T>::generation_record(successes));
   }
 }
 
 /*! Private member functions */
 
 template <class T>
-void DEGL<T>::initialize_weights() {
-  w_.resize(Base<T>::N_);
-  w_mutated_.resize(Base<T>::N_);
-  for (auto& w : w_)
-    w = rand_uniform_real(0.05, 0.95);
+void DEGL<T>::generate_trials(const std::size_t begin,
+                              const std::size_t end,
+                              const std::size_t global_best) {
+  for (std::size_t i = begin; i < end; ++i) {
+    ScopedRandomStream stream(Base<T>::stream_key(i, RandomPurpose::trial));
+    auto v = Base<T>::trials_[i];
+    mutate(i, global_best, v);
+    {
+      DE_PROFILE_PHASE(crossover);
+      binary_crossover<T>(Base<T>::x_[i], v, Cr, v);
+    }
+  }
+  Base<T>::evaluate_trials(begin, end);
 }
 
 template <class T>
-std::vector<std::size_t> DEGL<T>::get_neighborhood_indexes(
-    const std::size_t index) const {
-  std::vector<std::size_t> places;
-  places.reserve(2 * k_);
-  // Forward
-  std::size_t fwd = index, counter = 0;
-
-  while (++counter <= k_) {
-    if (++fwd == Base<T>::N_)
-      fwd = 0;
-
-    places.push_back(fwd);
-  }
-
-  // Backwards
-  counter = 0;
-  std::size_t bck = index;
-
-  while (++counter <= k_) {
-    if (bck-- == 0)
-      bck = Base<T>::N_ - 1;
-
-    places.push_back(bck);
+void DEGL<T>::initialize_weights() {
+  w_.resize(Base<T>::N_);
+  w_mutated_.resize(Base<T>::N_);
+  donors_.resize(Base<T>::N_);
+  random_bits_.resize(4 * Base<T>::N_);
+  for (std::size_t i = 0; i < Base<T>::N_; ++i) {
+    ScopedRandomStream stream(
+        Base<T>::stream_key(i, RandomPurpose::parameters));
+    w_[i] = rand_uniform_real(0.05, 0.95);
   }
-
-  return places;
 }
 
 template <class T>
-std::array<std::size_t, 2> DEGL<T>::get_random_local_indexes(
-    const std::vector<std::size_t>& places) const {
-  std::array<std::size_t, 2> rand;
-  std::size_t r1, r2;
-  r1 = rand_uniform_int(0, places.size() - 1);
-  rand[0] = places[r1];
-
-  do {
-    r2 = rand_uniform_int(0, places.size() - 1);
-  } while (r2 == r1);
-
-  rand[1] = places[r2];
-  return rand;
+std::size_t DEGL<T>::get_neighbor(const std::size_t index,
+                                  const std::size_t n) const {
+  assert(n < 2 * k_);
+  const std::size_t N = Base<T>::N_;
+  return n < k_ ? (index + n + 1) % N  // Forward
+                : (index + N - (n - k_ + 1) % N) % N;  // Backwards
 }
 
 template <class T>
-std::array<std::size_t, 2> DEGL<T>::get_random_global_indexes(
-    const std::size_t avoid) const {
-  std::array<std::size_t, 2> r;
-  do {
-    r[0] = rand_uniform_int(0, Base<T>::N_ - 1);
-  } while (r[0] == avoid);
-  do {
-    r[1] = rand_uniform_int(0, Base<T>::N_ - 1);
-  } while (r[1] == r[0] || r[1] == avoid);
-  return r;
+void DEGL<T>::draw_parameters() {
+  const std::size_t N = Base<T>::N_;
+  ScopedRandomStream stream(Base<T>::stream_key(0, RandomPurpose::generation));
+  fill_random_bits(random_bits_.data(), 4 * N);
+  for (std::size_t i = 0; i < N; ++i) {
+    const std::uint32_t* bits = &random_bits_[4 * i];
+    auto& donors = donors_[i];
+    // Two different neighbors
+    const std::size_t n_1 = uniform_index(bits[0], 2 * k_);
+    std::size_t n_2 = uniform_index(bits[1], 2 * k_ - 1);
+    if (n_2 >= n_1)
+      ++n_2;
+    donors[0] = get_neighbor(i, n_1);
+    donors[1] = get_neighbor(i, n_2);
+    // Two different chromosomes, both different from i; skip the excluded
+    // indices in increasing order
+    std::size_t g_1 = uniform_index(bits[2], N - 1);
+    if (g_1 >= i)
+      ++g_1;
+    std::size_t g_2 = uniform_index(bits[3], N - 2);
+    if (g_2 >= std::min(i, g_1))
+      ++g_2;
+    if (g_2 >= std::max(i, g_1))
+      ++g_2;
+    donors[2] = g_1;
+    donors[3] = g_2;
+  }
 }
 
 template <class T>
-std::size_t DEGL<T>::find_local_best(
-    const std::vector<std::size_t>& places) const {
-  double best = Base<T>::fit_[places[0]];
-  std::size_t pbest = places[0];
-
-  for (std::size_t i = 1; i < places.size(); ++i) {
-    if (Base<T>::compare_fitnesses(best, Base<T>::fit_[places[i]])) {
-      best = Base<T>::fit_[places[i]];
-      pbest = places[i];
+std::size_t DEGL<T>::find_local_best(const std::size_t index) const {
+  std::size_t pbest = get_neighbor(index, 0);
+  double best = Base<T>::fit_[pbest];
+
+  for (std::size_t n = 1; n < 2 * k_; ++n) {
+    const std::size_t neighbor = get_neighbor(index, n);
+    if (Base<T>::compare_fitnesses(best, Base<T>::fit_[neighbor])) {
+      best = Base<T>::fit_[neighbor];
+      pbest = neighbor;
     }
   }
 
@@ -142,30 +168,33 @@ std::size_t DEGL<T>::find_local_best(
 }
 
 template <class T>
-std::vector<T> DEGL<T>::mutate(const std::size_t index,
-                               const std::size_t global_best) {
-  const auto places = get_neighborhood_indexes(index);
-  const auto local_rand = get_random_local_indexes(places);
-  const auto local_best = find_local_best(places);
-  const auto global_rand = get_random_global_indexes(index);
-
-  std::vector<T> v(Base<T>::x_[index]);
+void DEGL<T>::mutate(const std::size_t index,
+                     const std::size_t global_best,
+                     RowView<T> v) {
+  DE_PROFILE_PHASE(mutation);
+  assert(v.size() == Base<T>::D_);
+  const auto& donors = donors_[index];
+  const auto local_best = find_local_best(index);
+
+  const auto x_i = Base<T>::x_[index], x_g = Base<T>::x_[global_best],
+             x_r_1 = Base<T>::x_[donors[2]], x_r_2 = Base<T>::x_[donors[3]],
+             x_l = Base<T>::x_[local_best], x_l_1 = Base<T>::x_[donors[0]],
+             x_l_2 = Base<T>::x_[donors[1]];
   w_mutated_[index] = w_[index] + F * (w_[global_best] - w_[index]) +
-                      F * (w_[global_rand[0]] - w_[global_rand[1]]);
+                      F * (w_[donors[2]] - w_[donors[3]]);
   w_mutated_[index] = std::max(0.05, std::min(0.95, double(w_mutated_[index])));
-  for (std::size_t i = 0; i < Base<T>::D_; ++i) {
-    v[i] =
-        w_mutated_[index] *
-            (this->x_[index][i] +
-             F * (this->x_[global_best][i] - this->x_[index][i]) +
-             F * (this->x_[global_rand[0]][i] - this->x_[global_rand[1]][i])) +
-        (1 - w_mutated_[index]) *
-            (this->x_[index][i] +
-             F * (this->x_[local_best][i] - this->x_[index][i]) +
-             F * (this->x_[local_rand[0]][i] - this->x_[local_rand[1]][i]));
-  }
-  Base<T>::p_problem_->constrain(v);
-  return v;
+  const float w = w_mutated_[index];
+  with_dimension(Base<T>::D_, [&](const auto D) {
+    const T *x = x_i.data(), *g = x_g.data(), *r_1 = x_r_1.data(),
+            *r_2 = x_r_2.data(), *l = x_l.data(), *l_1 = x_l_1.data(),
+            *l_2 = x_l_2.data();
+    T* out = v.data();
+    for (std::size_t i = 0; i < D; ++i)
+      out[i] = w * (x[i] + F * (g[i] - x[i]) + F * (r_1[i] - r_2[i])) +
+               (1 - w) * (x[i] + F * (l[i] - x[i]) + F * (l_1[i] - l_2[i]));
+  });
+  DE_PROFILE_PHASE(repair);
+  Base<T>::p_problem_->constrain_trial(v, x_i);
 }
 
 // explicit instantiations
@@ -1,8 +1,11 @@
 #include "algorithm/shade.hpp"
+#include <cmath>
+#include <limits>
 #include <numeric>
 #include <assert.h>
-#include <thread>
 #include "algorithm/differential_evolution.hpp"
+#include "dimension.hpp"
+#include "profiler.hpp"
 #include "rand.hpp"
 
 namespace DE {
@@ -12,20 +15,23 @@ template <class T>
 SHADE<T>::SHADE(std::shared_ptr<Problem::Base<T>> problem,
                 const std::vector<T>& initial_chromosome,
                 const bool use_linear_size_reduction,
-                const bool minimize)
+                const bool minimize,
+                std::shared_ptr<Executor> executor,
+                const std::size_t run)
     : Base<T>(problem,
               initial_chromosome,
               18 * problem->get_number_of_genes(),
-              minimize),
+              minimize,
+              executor,
+              run),
       N_(Base<T>::N_),
       p_(0.11 * N_),
       H_(6),
       A_size_(2.6 * N_),
+      A_(A_size_, Base<T>::D_),
+      A_count_(0),
       use_linear_size_reduction_(use_linear_size_reduction) {
-  A_.reserve(A_size_);
-  top_p_.resize(p_);
-  Cr_.resize(H_, 0.5);
-  F_.resize(H_, 0.5);
+  initialize_buffers();
 }
 
 template <class T>
@@ -33,167 +39,192 @@ SHADE<T>::SHADE(std::shared_ptr<Problem::Base<T>> problem,
                 const std::vector<T>& initial_chromosome,
                 const double initial_fitness,
                 const bool use_linear_size_reduction,
-                const bool minimize)
+                const bool minimize,
+                std::shared_ptr<Executor> executor,
+                const std::size_t run)
     : Base<T>(problem,
               initial_chromosome,
               18 * problem->get_number_of_genes(),
-              minimize),
+              minimize,
+              executor,
+              run),
       N_(Base<T>::N_),
       p_(0.11 * N_),
       H_(6),
       A_size_(2.6 * N_),
+      A_(A_size_, Base<T>::D_),
+      A_count_(0),
       use_linear_size_reduction_(use_linear_size_reduction) {
-  A_.reserve(A_size_);
-  top_p_.resize(p_);
-  Cr_.resize(H_, 0.5);
-  F_.resize(H_, 0.5);
+  initialize_buffers();
   Base<T>::fit_[0] = initial_fitness;
 }
 
 template <class T>
 SHADE<T>::SHADE(std::shared_ptr<Problem::Base<T>> problem,
                 const bool use_linear_size_reduction,
-                const bool minimize)
+                const bool minimize,
+                std::shared_ptr<Executor> executor,
+                const std::size_t run)
     : Base<T>(problem,
               18 * problem->get_number_of_genes(),
-              minimize),
+              minimize,
+              executor,
+              run),
       N_(Base<T>::N_),
       p_(0.11 * N_),
       H_(6),
       A_size_(2.6 * N_),
+      A_(A_size_, Base<T>::D_),
+      A_count_(0),
       use_linear_size_reduction_(use_linear_size_reduction) {
-  A_.reserve(A_size_);
-  top_p_.resize(p_);
-  Cr_.resize(H_, 0.5);
-  F_.resize(H_, 0.5);
+  initialize_buffers();
 }
 
 template <class T>
 void SHADE<T>::evolve_population(const std::size_t max_generations) {
-#ifdef CEC_MAX_EVALUATIONS
-  const std::size_t max_evaluations = Base<T>::D_ * 10e4;
-  std::size_t evaluations = 0;
-#endif
-  std::vector<float> S_Cr, S_F;
-  std::vector<double> delta_fit;
-  const size_t num_threads = std::thread::hardware_concurrency();
-  std::vector<std::thread> threads(num_threads);
   for (std::size_t g = 0; g < max_generations; ++g) {
-    S_Cr.clear();
-    S_F.clear();
-    delta_fit.clear();
+    const std::size_t trials = Base<T>::trials_within_limit(N_);
+    if (trials == 0)
+      break;
+    S_Cr_.clear();
+    S_F_.clear();
+    delta_fit_.clear();
     update_top_p_solutions();
+    draw_parameters();
 
-    if (Base<T>::allow_parallel_) {
-      for (size_t i = 0; i < num_threads; ++i)
-        threads[i] =
-            std::thread(&SHADE<T>::parallel_evolve, this, i, std::ref(S_Cr),
-                        std::ref(S_F), std::ref(delta_fit));
-
-      for (size_t i = 0; i < num_threads; ++i)
-        threads[i].join();
-    } else {
-      for (std::size_t i = 0; i < N_; ++i) {
-        const auto r_i = rand_uniform_int(0, H_ - 1);
-        const auto Cr = get_crossover_factor(r_i);
-        const auto F = get_scale_factor(r_i);
-        const auto mutant = mutate(i, F);
-        auto trial = binary_crossover<T>(Base<T>::x_[i], mutant, Cr);
-        const auto trial_fitness = Base<T>::p_problem_->fitness(trial);
-        if (Base<T>::compare_fitnesses_with_equality(Base<T>::fit_[i],
-                                                     trial_fitness)) {
-          std::swap(Base<T>::x_[i], trial);
-          if (Base<T>::fit_[i] != trial_fitness) {
-            add_to_archive(trial);
-            S_Cr.push_back(Cr);
-            S_F.push_back(F);
-            delta_fit.push_back(fabs(Base<T>::fit_[i] - trial_fitness));
-            Base<T>::fit_[i] = trial_fitness;
-          }
-        }
-      }
+    // Trials only read the population, archive and memories of the
+    // previous generation, so chunks of them are independent
+    Base<T>::executor_->parallel_for(
+        trials, [this](const std::size_t begin, const std::size_t end) {
+          generate_trials(begin, end);
+        });
+    {
+      DE_PROFILE_PHASE(selection);
+      for (std::size_t i = 0; i < trials; ++i)
+        select(i);
     }
+    Base<T>::evaluations_ += trials;
+    ++Base<T>::generation_;
 
-#ifdef CEC_MAX_EVALUATIONS
-    evaluations += N_;
-    if (evaluations > max_evaluations)
+    const bool exhausted = Base<T>::evaluations_exhausted();
+    if (!exhausted) {
+      memory_update(g % H_);
+      if (use_linear_size_reduction_)
+        linear_size_reduction(g, max_generations);
+    }
+    if (Base<T>::observer_)
+      report_generation();
+    if (exhausted)
       break;
-#endif
-    memory_update(S_Cr, S_F, delta_fit, g % H_);
-    if (use_linear_size_reduction_)
-      linear_size_reduction(g, max_generations);
   }
 }
 
 template <class T>
-void SHADE<T>::parallel_evolve(const std::size_t thread_id,
-                               std::vector<float>& S_Cr,
-                               std::vector<float>& S_F,
-                               std::vector<double>& delta_fit) {
-  for (std::size_t i = thread_id; i < N_;
-       i += std::thread::hardware_concurrency()) {
-    const auto r_i = rand_uniform_int(0, H_ - 1);
-    pop_mutex_.lock();
-    const auto Cr = get_crossover_factor(r_i);
-    const auto F = get_scale_factor(r_i);
-    const auto mutant = mutate(i, F);
-    auto trial = binary_crossover<T>(Base<T>::x_[i], mutant, Cr);
-    pop_mutex_.unlock();
-    const auto trial_fitness = Base<T>::p_problem_->fitness(trial);
-    if (Base<T>::compare_fitnesses_with_equality(Base<T>::fit_[i],
-                                                 trial_fitness)) {
-      pop_mutex_.lock();
-      std::swap(Base<T>::x_[i], trial);
-      if (Base<T>::fit_[i] != trial_fitness) {
-        add_to_archive(trial);
-        S_Cr.push_back(Cr);
-        S_F.push_back(F);
-        delta_fit.push_back(fabs(Base<T>::fit_[i] - trial_fitness));
-        Base<T>::fit_[i] = trial_fitness;
-      }
-      pop_mutex_.unlock();
+void SHADE<T>::report_generation() const {
+  auto record = Base<T>::generation_record(S_F_.size());
+  record.archive_size = A_count_;
+  record.archive_capacity = A_size_;
+  record.memory_size =
+      std::min(H_, std::size_t(GenerationRecord::max_memory_size));
+  std::copy_n(F_.begin(), record.memory_size, record.memory_F.begin());
+  std::copy_n(Cr_.begin(), record.memory_size, record.memory_Cr.begin());
+  Base<T>::observer_->on_generation(record);
+}
+
+template <class T>
+void SHADE<T>::generate_trials(const std::size_t begin,
+                               const std::size_t end) {
+  for (std::size_t i = begin; i < end; ++i) {
+    ScopedRandomStream stream(Base<T>::stream_key(i, RandomPurpose::trial));
+    auto trial = Base<T>::trials_[i];
+    mutate(i, trial_F_[i], trial);
+    {
+      DE_PROFILE_PHASE(crossover);
+      binary_crossover<T>(Base<T>::x_[i], trial, trial_Cr_[i], trial);
     }
   }
+  Base<T>::evaluate_trials(begin, end);
 }
 
 template <class T>
-float SHADE<T>::get_crossover_factor(const std::size_t rand_index) const {
-  auto Cr = (Cr_[rand_index] == TERMINAL_VALUE) ? 0 : rand_normal(
-                                                          Cr_[rand_index], 0.1);
+void SHADE<T>::select(const std::size_t i) {
+  const double trial_fitness = Base<T>::trial_fit_[i];
+  if (!Base<T>::compare_fitnesses_with_equality(Base<T>::fit_[i],
+                                                trial_fitness))
+    return;
+  if (Base<T>::fit_[i] != trial_fitness) {
+    ScopedRandomStream stream(
+        Base<T>::stream_key(i, RandomPurpose::selection));
+    add_to_archive(Base<T>::x_[i]);
+    S_Cr_.push_back(trial_Cr_[i]);
+    S_F_.push_back(trial_F_[i]);
+    delta_fit_.push_back(fabs(Base<T>::fit_[i] - trial_fitness));
+    Base<T>::fit_[i] = trial_fitness;
+  }
+  const auto trial = Base<T>::trials_[i];
+  std::copy(trial.begin(), trial.end(), Base<T>::x_[i].begin());
+}
+
+template <class T>
+void SHADE<T>::draw_parameters() {
+  ScopedRandomStream stream(Base<T>::stream_key(0, RandomPurpose::generation));
+  // Four draws per trial: memory index, p-best, r_1 and r_2
+  fill_random_bits(random_bits_.data(), 4 * N_);
+  fill_normal(normal_draws_.data(), N_, 0.0, 1.0);
+  fill_uniform_real(uniform_draws_.data(), N_, 0.0, 1.0);
+  for (std::size_t i = 0; i < N_; ++i) {
+    const std::uint32_t* bits = &random_bits_[4 * i];
+    const std::size_t r_i = uniform_index(bits[0], H_);
+    trial_Cr_[i] = get_crossover_factor(r_i, normal_draws_[i]);
+    trial_F_[i] = get_scale_factor(r_i, uniform_draws_[i]);
+    auto& donors = donors_[i];
+    donors[0] = top_p_[uniform_index(bits[1], p_)];
+    donors[1] = uniform_index(bits[2], N_ - 1);  // Any index except i
+    if (donors[1] >= i)
+      ++donors[1];
+    donors[2] = uniform_index(bits[3], N_ + A_count_ - 1);
+  }
+}
+
+template <class T>
+float SHADE<T>::get_crossover_factor(const std::size_t rand_index,
+                                     const double z) const {
+  auto Cr = (Cr_[rand_index] == TERMINAL_VALUE) ? 0 : Cr_[rand_index] + 0.1 * z;
   return std::min(std::max(Cr, 0.0), 1.0);
 }
 
 template <class T>
-float SHADE<T>::get_scale_factor(const std::size_t rand_index) const {
-  float F;
-  do {
-    F = rand_cauchy(F_[rand_index], 0.1);
-    if (F > 1)
-      return 1.0;
-  } while (F <= 0.0);
-  return F;
+float SHADE<T>::get_scale_factor(const std::size_t rand_index,
+                                 const double u) const {
+  // Invert the CDF of Cauchy(F_[rand_index], 0.1) restricted to F > 0, which
+  // is what regenerating non-positive values amounts to
+  const double location = F_[rand_index], scale = 0.1;
+  const double p_0 = 0.5 + std::atan(-location / scale) / M_PI;  // P(F <= 0)
+  const double F =
+      location + scale * std::tan(M_PI * (p_0 + (1 - p_0) * u - 0.5));
+  if (F > 1)
+    return 1.0;
+  return std::max(float(F), std::numeric_limits<float>::min());
 }
 
 template <class T>
-void SHADE<T>::memory_update(const std::vector<float>& S_Cr,
-                             const std::vector<float>& S_F,
-                             const std::vector<double>& delta_fit,
-                             const std::size_t k) {
-  assert(S_Cr.size() == S_F.size());
-  assert(S_Cr.size() == delta_fit.size());
+void SHADE<T>::memory_update(const std::size_t k) {
+  DE_PROFILE_PHASE(memory_update);
+  assert(S_Cr_.size() == S_F_.size());
+  assert(S_Cr_.size() == delta_fit_.size());
   assert(k < H_);
-  if (!S_Cr.empty()) {
-    std::vector<double> weights(delta_fit);
-    auto sum = std::accumulate(delta_fit.begin(), delta_fit.end(), 0.0);
-    for (auto& w : weights)
+  if (!S_Cr_.empty()) {
+    weights_.assign(delta_fit_.begin(), delta_fit_.end());
+    auto sum = std::accumulate(delta_fit_.begin(), delta_fit_.end(), 0.0);
+    for (auto& w : weights_)
       w /= sum;
     if (Cr_[k] == TERMINAL_VALUE ||
-        *std::max_element(S_Cr.begin(), S_Cr.end()) == 0) {
+        *std::max_element(S_Cr_.begin(), S_Cr_.end()) == 0) {
       Cr_[k] = TERMINAL_VALUE;
     } else {
-      Cr_[k] = weighted_lehmer_mean(weights, S_Cr);
+      Cr_[k] = weighted_lehmer_mean(weights_, S_Cr_);
     }
-    F_[k] = weighted_lehmer_mean(weights, S_F);
+    F_[k] = weighted_lehmer_mean(weights_, S_F_);
   }
 }
 
@@ -209,82 +240,118 @@ float SHADE<T>::weighted_lehmer_mean(const std::vector<double>& weights,
 }
 
 template <class T>
-void SHADE<T>::add_to_archive(const std::vector<T>& chromosome) {
-  if (A_.size() >= A_size_) {  // overwrite random
-    std::size_t rand_index = rand_uniform_int(0, A_.size() - 1);
-    A_[rand_index] = chromosome;
-  } else {
-    A_.push_back(chromosome);
-  }
+void SHADE<T>::add_to_archive(ConstRowView<T> chromosome) {
+  DE_PROFILE_PHASE(archive);
+  if (A_size_ == 0)
+    return;
+  std::size_t index = A_count_;
+  if (A_count_ >= A_size_)  // overwrite random
+    index = rand_uniform_int(0, A_count_ - 1);
+  else
+    ++A_count_;
+  std::copy(chromosome.begin(), chromosome.end(), A_[index].begin());
 }
 
 template <class T>
 void SHADE<T>::update_top_p_solutions() {
-  std::vector<std::size_t> indices(N_, 0);
-  std::iota(indices.begin(), indices.end(), 0);
-  std::partial_sort(indices.begin(), indices.begin() + p_, indices.end(),
+  DE_PROFILE_PHASE(top_p);
+  assert(indices_.size() == N_);
+  std::iota(indices_.begin(), indices_.end(), 0);
+  std::partial_sort(indices_.begin(), indices_.begin() + p_, indices_.end(),
                     [this](const auto& first, const auto& second) {
                       return !this->compare_fitnesses(this->fit_[first],
                                                       this->fit_[second]);
                     });
   for (std::size_t i = 0; i < p_; ++i)
-    top_p_[i] = indices[i];
+    top_p_[i] = indices_[i];
 }
 
 template <class T>
-std::vector<T> SHADE<T>::mutate(const std::size_t base_index,
-                                const float F) const {
+void SHADE<T>::mutate(const std::size_t base_index,
+                      const float F,
+                      RowView<T> mutant) const {
+  DE_PROFILE_PHASE(mutation);
   assert(base_index < N_);
   assert(F > 0);
-  auto mutant = Base<T>::x_[base_index];
-  std::size_t rand_pbest_index =
-                  (p_ <= 1) ? top_p_[0] : top_p_[rand_uniform_int(0, p_ - 1)],
-              rand_1, rand_2 = rand_uniform_int(0, N_ + A_.size() - 2);
-  do {
-    rand_1 = rand_uniform_int(0, N_ - 1);
-  } while (rand_1 == base_index);
-  const std::vector<T>& x_r_2 =
-      (rand_2 >= N_) ? A_[rand_2 - N_] : Base<T>::x_[rand_2];
-  for (std::size_t j = 0; j < Base<T>::D_; ++j) {
-    mutant[j] += F * (Base<T>::x_[rand_pbest_index][j] - mutant[j]) +
-                 F * (Base<T>::x_[rand_1][j] - x_r_2[j]);
-  }
-  Base<T>::p_problem_->constrain(mutant);
-  return mutant;
+  assert(mutant.size() == Base<T>::D_);
+  const auto x_i = Base<T>::x_[base_index];
+  const auto& donors = donors_[base_index];
+  const std::size_t rand_pbest_index = donors[0], rand_1 = donors[1],
+                    rand_2 = donors[2];
+  const auto x_pbest = Base<T>::x_[rand_pbest_index],
+             x_r_1 = Base<T>::x_[rand_1],
+             x_r_2 = (rand_2 >= N_) ? A_[rand_2 - N_] : Base<T>::x_[rand_2];
+  with_dimension(Base<T>::D_, [&](const auto D) {
+    const T *x = x_i.data(), *best = x_pbest.data(), *r_1 = x_r_1.data(),
+            *r_2 = x_r_2.data();
+    T* v = mutant.data();
+    for (std::size_t j = 0; j < D; ++j)
+      v[j] = x[j] + (F * (best[j] - x[j]) + F * (r_1[j] - r_2[j]));
+  });
+  DE_PROFILE_PHASE(repair);
+  Base<T>::p_problem_->constrain_trial(mutant, x_i);
 }
 
 template <class T>
 void SHADE<T>::linear_size_reduction(const std::size_t current_generation,
                                      const std::size_t max_generations) {
+  DE_PROFILE_PHASE(size_reduction);
   std::size_t N =
       (4.0 - 18 * Base<T>::D_) * current_generation / max_generations +
       18 * Base<T>::D_ + 1;
   if (N < N_) {
-    std::vector<std::size_t> indices(N_, 0);
-    std::iota(indices.begin(), indices.end(), 0);
-    std::sort(indices.begin(), indices.end(), [this](const auto& first,
-                                                     const auto& second) {
+    std::iota(indices_.begin(), indices_.end(), 0);
+    std::sort(indices_.begin(), indices_.end(), [this](const auto& first,
+                                                       const auto& second) {
       return this->compare_fitnesses(this->fit_[second], this->fit_[first]);
     });
-    auto new_population = Base<T>::x_;
-    std::transform(indices.begin(), indices.end(), new_population.begin(),
-                   [this](const auto& i) { return this->x_[i]; });
-    std::swap(Base<T>::x_, new_population);
-    auto new_fitnesses = Base<T>::fit_;
-    std::transform(indices.begin(), indices.end(), new_fitnesses.begin(),
-                   [this](const auto& i) { return this->fit_[i]; });
-    std::swap(Base<T>::fit_, new_fitnesses);
+    // The survivors are gathered into the (idle) trial buffers
+    for (std::size_t i = 0; i < N; ++i) {
+      const auto x_best = Base<T>::x_[indices_[i]];
+      std::copy(x_best.begin(), x_best.end(), Base<T>::trials_[i].begin());
+      scratch_fit_[i] = Base<T>::fit_[indices_[i]];
+    }
+    std::swap(Base<T>::x_, Base<T>::trials_);
+    std::swap(Base<T>::fit_, scratch_fit_);
     N_ = N;
     Base<T>::x_.resize(N_);
+    Base<T>::trials_.resize(N_);
     Base<T>::fit_.resize(N_);
+    Base<T>::trial_fit_.resize(N_);
+    scratch_fit_.resize(N_);
+    trial_Cr_.resize(N_);
+    trial_F_.resize(N_);
+    donors_.resize(N_);
+    random_bits_.resize(4 * N_);
+    normal_draws_.resize(N_);
+    uniform_draws_.resize(N_);
+    indices_.resize(N_);
     A_size_ = 2.6 * N_;
-    if (A_.size() > A_size_)
-      A_.resize(A_size_);
+    A_count_ = std::min(A_count_, A_size_);
     p_ = std::max(1.0, 0.11 * N_);
     top_p_.resize(p_);
   }
 }
 
+template <class T>
+void SHADE<T>::initialize_buffers() {
+  top_p_.resize(p_);
+  Cr_.resize(H_, 0.5);
+  F_.resize(H_, 0.5);
+  S_Cr_.reserve(N_);
+  S_F_.reserve(N_);
+  delta_fit_.reserve(N_);
+  weights_.reserve(N_);
+  indices_.resize(N_);
+  scratch_fit_.resize(N_);
+  trial_Cr_.resize(N_);
+  trial_F_.resize(N_);
+  donors_.resize(N_);
+  random_bits_.resize(4 * N_);
+  normal_draws_.resize(N_);
+  uniform_draws_.resize(N_);
+}
+
 // explicit instantiations
 template class SHADE<float>;
 template class SHADE<double>;
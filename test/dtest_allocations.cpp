@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+#include "problem/cec_basic_problem.hpp"
+#include "problem/rastrigin.hpp"
+#include "problem/hybrid_1.hpp"
+#include "problem/composition_1.hpp"
+#include "algorithm/shade.hpp"
+#include "algorithm/degl.hpp"
+#include "test_utils.hpp"
+
+namespace {
+
+std::atomic<bool> count_allocations(false);
+std::atomic<std::size_t> allocations(0);
+
+}  // namespace
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// Every heap allocation of the test executable goes through here
+void* operator new(std::size_t size) {
+  if (count_allocations)
+    ++allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+namespace {
+
+template <class Function>
+std::size_t allocations_during(Function&& f) {
+  allocations = 0;
+  count_allocations = true;
+  f();
+  count_allocations = false;
+  return allocations;
+}
+
+class Allocations : public ::testing::Test {
+ protected:
+  static constexpr std::size_t D = 10;
+
+  /*! A shifted and rotated, a hybrid and a composition function */
+  std::vector<std::shared_ptr<DE::Problem::CECFunction<double>>> problems() {
+    auto rastrigin =
+        std::make_shared<DE::Problem::RastriginFunction<double>>(D);
+    rastrigin->parse_shift_file(shift_file(5).c_str());
+    rastrigin->parse_rotation_file(rotation_file(5, D).c_str());
+    auto hybrid = std::make_shared<DE::Problem::HybridFunction1<double>>(
+        D, shuffle_file(11, D).c_str());
+    hybrid->parse_shift_file(shift_file(11).c_str());
+    hybrid->parse_rotation_file(rotation_file(11, D).c_str());
+    auto composition =
+        std::make_shared<DE::Problem::CompositionFunction1<double>>(
+            D, shift_file(21).c_str(), rotation_file(21, D).c_str());
+    return {rastrigin, hybrid, composition};
+  }
+};
+
+constexpr std::size_t Allocations::D;
+
+TEST_F(Allocations, shade_generation) {
+  for (const auto& f : problems()) {
+    DE::Algorithm::SHADE<double> shade(f, false);
+    shade.evolve_population(1);  // thread-local buffers of the problem grow
+    EXPECT_EQ(allocations_during([&shade] { shade.evolve_population(5); }),
+              0u)
+        << f->get_name();
+  }
+}
+
+TEST_F(Allocations, l_shade_generation) {
+  for (const auto& f : problems()) {
+    DE::Algorithm::SHADE<double> shade(f, true);
+    shade.evolve_population(1);
+    EXPECT_EQ(allocations_during([&shade] { shade.evolve_population(5); }),
+              0u)
+        << f->get_name();
+  }
+}
+
+TEST_F(Allocations, degl_generation) {
+  for (const auto& f : problems()) {
+    DE::Algorithm::DEGL<double> degl(f);
+    degl.evolve_population(1);
+    EXPECT_EQ(allocations_during([&degl] { degl.evolve_population(5); }), 0u)
+        << f->get_name();
+  }
+}
+
+}  // namespace
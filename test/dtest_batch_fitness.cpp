@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+#include "matrix.hpp"
+#include "rand.hpp"
+#include "problem/cec_basic_problem.hpp"
+#include "problem/rastrigin.hpp"
+#include "problem/lunacek_bi_rastrigin.hpp"
+#include "problem/hybrid_1.hpp"
+#include "problem/hybrid_7.hpp"
+#include "problem/composition_1.hpp"
+#include "problem/composition_7.hpp"
+#include "problem/composition_10.hpp"
+#include "test_utils.hpp"
+
+namespace {
+
+class BatchFitness : public ::testing::Test {
+ protected:
+  /*! Basic, hybrid and composition functions, shifted and rotated */
+  std::vector<std::shared_ptr<DE::Problem::CECFunction<double>>> problems(
+      const std::size_t D) {
+    std::vector<std::shared_ptr<DE::Problem::CECFunction<double>>> f = {
+        std::make_shared<DE::Problem::RastriginFunction<double>>(D),
+        std::make_shared<DE::Problem::LunacekBiRastriginFunction<double>>(D),
+        std::make_shared<DE::Problem::HybridFunction1<double>>(
+            D, shuffle_file(11, D).c_str()),
+        std::make_shared<DE::Problem::HybridFunction7<double>>(
+            D, shuffle_file(17, D).c_str())};
+    const std::size_t shifted[] = {5, 7, 11, 17};
+    for (std::size_t i = 0; i < f.size(); ++i) {
+      f[i]->parse_shift_file(shift_file(shifted[i]).c_str());
+      f[i]->parse_rotation_file(rotation_file(shifted[i], D).c_str());
+    }
+    f.push_back(std::make_shared<DE::Problem::CompositionFunction1<double>>(
+        D, shift_file(21).c_str(), rotation_file(21, D).c_str()));
+    f.push_back(std::make_shared<DE::Problem::CompositionFunction7<double>>(
+        D, shift_file(27).c_str(), rotation_file(27, D).c_str()));
+    f.push_back(std::make_shared<DE::Problem::CompositionFunction10<double>>(
+        D, shift_file(30).c_str(), rotation_file(30, D).c_str(),
+        shuffle_file(30, D).c_str()));
+    return f;
+  }
+};
+
+TEST_F(BatchFitness, same_values_as_fitness) {
+  constexpr std::size_t N = 150;  // more than a single chunk
+  for (const std::size_t D : {10, 30}) {
+    DE::Matrix<double> x(N, D);
+    for (std::size_t i = 0; i < N; ++i)
+      for (std::size_t j = 0; j < D; ++j)
+        x[i][j] = rand_uniform_real(-100, 100);
+    std::vector<double> fitness(N);
+    for (const auto& f : problems(D)) {
+      f->fitness_batch(x, fitness.data());
+      for (std::size_t i = 0; i < N; ++i)
+        EXPECT_EQ(f->fitness(x[i]), fitness[i]) << f->get_name();
+    }
+  }
+}
+
+TEST_F(BatchFitness, slice) {
+  constexpr std::size_t N = 20, D = 10;
+  DE::Matrix<double> x(N, D);
+  for (std::size_t i = 0; i < N; ++i)
+    for (std::size_t j = 0; j < D; ++j)
+      x[i][j] = rand_uniform_real(-100, 100);
+  DE::ConstBlockView<double> block(x);
+  const auto slice = block.slice(5, 10);
+  std::vector<double> fitness(slice.rows());
+  auto f = problems(D).back();
+  f->fitness_batch(slice, fitness.data());
+  for (std::size_t i = 0; i < slice.rows(); ++i)
+    EXPECT_EQ(f->fitness(x[5 + i]), fitness[i]);
+}
+
+}  // namespace
@@ -0,0 +1,231 @@
+#include "gtest/gtest.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "rand.hpp"
+#include "simd.hpp"
+#include "problem/simple_problem.hpp"
+
+namespace {
+
+using DE::Problem::BoundHandling;
+using DE::SIMD::InstructionSet;
+
+/*! Sphere with bounds [-i - 1, i + 1] per gene, or [-5, 5] for all */
+class Sphere : public DE::Problem::SimpleFitnessFunction<double> {
+ public:
+  Sphere(const std::size_t D, const bool uniform)
+      : SimpleFitnessFunction<double>(D, "Sphere") {
+    if (uniform)
+      set_bounds(-5, 5);
+    else
+      for (std::size_t i = 0; i < D; ++i)
+        set_bounds(i, -double(i) - 1, double(i) + 1);
+  }
+
+  double fitness(DE::ConstRowView<double> x) const {
+    double sum = 0.0;
+    for (const auto v : x)
+      sum += v * v;
+    return sum;
+  }
+};
+
+/*! Sphere with genes 1 in [0, inf) and 2 in (-inf, 5], the rest in [-5, 5] */
+class HalfBoundedSphere : public Sphere {
+ public:
+  explicit HalfBoundedSphere(const std::size_t D) : Sphere(D, true) {
+    set_bounds(1, 0, std::numeric_limits<double>::infinity());
+    set_bounds(2, -std::numeric_limits<double>::infinity(), 5);
+  }
+};
+
+class BoundHandlingTest : public ::testing::Test {
+ protected:
+  ~BoundHandlingTest() {
+    DE::SIMD::set_instruction_set(InstructionSet::avx512);
+  }
+
+  std::vector<InstructionSet> instruction_sets() const {
+    std::vector<InstructionSet> sets;
+    for (auto isa : {InstructionSet::scalar, InstructionSet::sse2,
+                     InstructionSet::avx2, InstructionSet::avx512})
+      if (isa <= DE::SIMD::detect_instruction_set())
+        sets.push_back(isa);
+    return sets;
+  }
+
+  static RandomStreamKey key() { return {SEED, 7, 3, 5, RandomPurpose::trial}; }
+};
+
+TEST_F(BoundHandlingTest, randomize_draws_as_rand_uniform_real) {
+  for (const bool uniform : {true, false}) {
+    constexpr std::size_t D = 13;
+    Sphere f(D, uniform);
+    for (auto isa : instruction_sets()) {
+      DE::SIMD::set_instruction_set(isa);
+      std::vector<double> x(D), expected(D);
+      {
+        ScopedRandomStream stream(key());
+        for (std::size_t i = 0; i < D; ++i)
+          expected[i] = rand_uniform_real(f.get_lower_bounds()[i],
+                                          f.get_upper_bounds()[i]);
+      }
+      ScopedRandomStream stream(key());
+      f.randomize(x);
+      for (std::size_t i = 0; i < D; ++i)
+        EXPECT_EQ(x[i], expected[i]) << uniform << " " << DE::SIMD::name(isa);
+    }
+  }
+}
+
+TEST_F(BoundHandlingTest, random_redraws_the_genes_outside_in_order) {
+  constexpr std::size_t D = 13;
+  Sphere f(D, false);
+  std::vector<double> x(D), expected(D);
+  for (std::size_t i = 0; i < D; ++i)
+    x[i] = i % 3 == 0 ? 2.0 * (i + 1) : 0.5;
+  {
+    ScopedRandomStream stream(key());
+    for (std::size_t i = 0; i < D; ++i)
+      expected[i] = i % 3 == 0 ? rand_uniform_real(-double(i) - 1, i + 1.0)
+                               : 0.5;
+  }
+  ScopedRandomStream stream(key());
+  f.constrain(x);
+  EXPECT_EQ(x, expected);
+}
+
+TEST_F(BoundHandlingTest, deterministic_policies) {
+  constexpr std::size_t D = 11;
+  for (const bool uniform : {true, false}) {
+    Sphere f(D, uniform);
+    const auto& lower = f.get_lower_bounds();
+    const auto& upper = f.get_upper_bounds();
+    std::vector<double> x(D), parent(D);
+    for (std::size_t i = 0; i < D; ++i) {
+      // Below, above, within, and far beyond (reflected past the other side)
+      const double width = upper[i] - lower[i];
+      x[i] = i % 4 == 0   ? lower[i] - 0.25
+             : i % 4 == 1 ? upper[i] + 0.5
+             : i % 4 == 2 ? lower[i] + 0.5
+                          : upper[i] + 3 * width;
+      parent[i] = upper[i] - 0.125;
+    }
+    for (auto isa : instruction_sets()) {
+      DE::SIMD::set_instruction_set(isa);
+      const auto name = DE::SIMD::name(isa);
+
+      std::vector<double> y = x;
+      f.set_bound_handling(BoundHandling::clip);
+      f.constrain_trial(y, parent);
+      for (std::size_t i = 0; i < D; ++i)
+        EXPECT_EQ(y[i], std::max(lower[i], std::min(x[i], upper[i]))) << name;
+
+      y = x;
+      f.set_bound_handling(BoundHandling::reflect);
+      f.constrain_trial(y, parent);
+      for (std::size_t i = 0; i < D; ++i) {
+        const double expected = i % 4 == 0   ? lower[i] + 0.25
+                                : i % 4 == 1 ? upper[i] - 0.5
+                                : i % 4 == 2 ? x[i]
+                                             : lower[i];
+        EXPECT_EQ(y[i], expected) << i << " " << name;
+      }
+
+      y = x;
+      f.set_bound_handling(BoundHandling::midpoint);
+      f.constrain_trial(y, parent);
+      for (std::size_t i = 0; i < D; ++i) {
+        const double expected = i % 4 == 0   ? (lower[i] + parent[i]) / 2
+                                : i % 4 == 2 ? x[i]
+                                             : (upper[i] + parent[i]) / 2;
+        EXPECT_EQ(y[i], expected) << i << " " << name;
+      }
+
+      // Without a parent, midpoint clips
+      y = x;
+      f.constrain(y);
+      for (std::size_t i = 0; i < D; ++i)
+        EXPECT_EQ(y[i], std::max(lower[i], std::min(x[i], upper[i]))) << name;
+    }
+  }
+}
+
+TEST_F(BoundHandlingTest, half_bounded_genes) {
+  constexpr std::size_t D = 7;
+  HalfBoundedSphere f(D);
+  const auto& lower = f.get_lower_bounds();
+  const auto& upper = f.get_upper_bounds();
+  EXPECT_EQ(lower[1], 0.0);
+  EXPECT_EQ(upper[2], 5.0);
+  EXPECT_TRUE(std::isfinite(upper[1]) && std::isfinite(lower[2]));
+  EXPECT_TRUE(std::isfinite(upper[1] - lower[1]));
+  EXPECT_TRUE(std::isfinite(upper[2] - lower[2]));
+
+  for (auto isa : instruction_sets()) {
+    DE::SIMD::set_instruction_set(isa);
+    const auto name = DE::SIMD::name(isa);
+    std::vector<double> x(D);
+    f.randomize(x);
+    for (std::size_t i = 0; i < D; ++i) {
+      EXPECT_TRUE(std::isfinite(x[i])) << i << " " << name;
+      EXPECT_LE(lower[i], x[i]) << i << " " << name;
+      EXPECT_LE(x[i], upper[i]) << i << " " << name;
+    }
+
+    // Gene 1 below its finite bound, gene 2 above it
+    std::vector<double> trial(D, 0.5), parent(D, 0.5);
+    trial[1] = -3;
+    trial[2] = 7;
+    parent[1] = 1;
+    parent[2] = 4;
+    for (const auto policy : {BoundHandling::random, BoundHandling::clip,
+                              BoundHandling::reflect,
+                              BoundHandling::midpoint}) {
+      f.set_bound_handling(policy);
+      auto y = trial;
+      f.constrain_trial(y, parent);
+      for (std::size_t i = 0; i < D; ++i) {
+        EXPECT_TRUE(std::isfinite(y[i])) << i << " " << name;
+        EXPECT_LE(lower[i], y[i]) << i << " " << name;
+        EXPECT_LE(y[i], upper[i]) << i << " " << name;
+      }
+      for (const std::size_t i : {0u, 3u, 4u, 5u, 6u})
+        EXPECT_EQ(y[i], 0.5) << i << " " << name;
+      if (policy == BoundHandling::clip) {
+        EXPECT_EQ(y[1], 0.0) << name;
+        EXPECT_EQ(y[2], 5.0) << name;
+      } else if (policy == BoundHandling::reflect) {
+        EXPECT_EQ(y[1], 3.0) << name;
+        EXPECT_EQ(y[2], 3.0) << name;
+      } else if (policy == BoundHandling::midpoint) {
+        EXPECT_EQ(y[1], 0.5) << name;
+        EXPECT_EQ(y[2], 4.5) << name;
+      }
+    }
+  }
+}
+
+TEST_F(BoundHandlingTest, constrain_batch) {
+  constexpr std::size_t N = 5, D = 9;
+  Sphere f(D, true);
+  f.set_bound_handling(BoundHandling::midpoint);
+  DE::Matrix<double> x(N, D), parents(N, D);
+  for (std::size_t r = 0; r < N; ++r)
+    for (std::size_t j = 0; j < D; ++j) {
+      x[r][j] = rand_uniform_real(-10, 10);
+      parents[r][j] = rand_uniform_real(-5, 5);
+    }
+  DE::Matrix<double> expected = x;
+  for (std::size_t r = 0; r < N; ++r)
+    f.constrain_trial(expected[r], parents[r]);
+  f.constrain_batch(x, parents);
+  for (std::size_t r = 0; r < N; ++r)
+    for (std::size_t j = 0; j < D; ++j) {
+      EXPECT_EQ(x[r][j], expected[r][j]);
+      EXPECT_LE(std::abs(x[r][j]), 5.0);
+    }
+}
+
+}  // namespace
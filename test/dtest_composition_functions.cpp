@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <cstdio>
 #include <memory>
 #include "problem/cec_composition_function.hpp"
 #include "problem/composition_1.hpp"
@@ -14,8 +15,9 @@
 #include "test_utils.hpp"
 #include "cec17_test_func.hpp"
 
+template <class T>
 void initialize_function(
-    std::unique_ptr<DE::Problem::CECComposition<double>>& function,
+    std::unique_ptr<DE::Problem::CECComposition<T>>& function,
     const std::size_t num,
     const std::size_t D,
     const bool use_rotation) {
@@ -26,43 +28,43 @@ void initialize_function(
        shuffle_f = shuffle_str.c_str();
   switch (num) {
     case 21:
-      function = std::make_unique<DE::Problem::CompositionFunction1>(
+      function = std::make_unique<DE::Problem::CompositionFunction1<T>>(
           D, shift_f, rotation_f);
       break;
     case 22:
-      function = std::make_unique<DE::Problem::CompositionFunction2>(
+      function = std::make_unique<DE::Problem::CompositionFunction2<T>>(
           D, shift_f, rotation_f);
       break;
     case 23:
-      function = std::make_unique<DE::Problem::CompositionFunction3>(
+      function = std::make_unique<DE::Problem::CompositionFunction3<T>>(
           D, shift_f, rotation_f);
       break;
     case 24:
-      function = std::make_unique<DE::Problem::CompositionFunction4>(
+      function = std::make_unique<DE::Problem::CompositionFunction4<T>>(
           D, shift_f, rotation_f);
       break;
     case 25:
-      function = std::make_unique<DE::Problem::CompositionFunction5>(
+      function = std::make_unique<DE::Problem::CompositionFunction5<T>>(
           D, shift_f, rotation_f);
       break;
     case 26:
-      function = std::make_unique<DE::Problem::CompositionFunction6>(
+      function = std::make_unique<DE::Problem::CompositionFunction6<T>>(
           D, shift_f, rotation_f);
       break;
     case 27:
-      function = std::make_unique<DE::Problem::CompositionFunction7>(
+      function = std::make_unique<DE::Problem::CompositionFunction7<T>>(
           D, shift_f, rotation_f);
       break;
     case 28:
-      function = std::make_unique<DE::Problem::CompositionFunction8>(
+      function = std::make_unique<DE::Problem::CompositionFunction8<T>>(
           D, shift_f, rotation_f);
       break;
     case 29:
-      function = std::make_unique<DE::Problem::CompositionFunction9>(
+      function = std::make_unique<DE::Problem::CompositionFunction9<T>>(
           D, shift_f, rotation_f, shuffle_f);
       break;
     case 30:
-      function = std::make_unique<DE::Problem::CompositionFunction10>(
+      function = std::make_unique<DE::Problem::CompositionFunction10<T>>(
           D, shift_f, rotation_f, shuffle_f);
       break;
   }
@@ -88,4 +90,43 @@ TEST_F(CompositionFunctions, same_values_shifted_and_rotated) {
   }
 }
 
+TEST_F(CompositionFunctions, float_accuracy) {
+  std::unique_ptr<DE::Problem::CECComposition<float>> function;
+  double fitness;
+  for (std::size_t i = 21; i <= 30; ++i) {
+    double error = 0.0;
+    for (auto& x : x_tests) {
+      initialize_function(function, i, x.size(), true);
+      cec17_test_func(x.data(), &fitness, x.size(), 1, i);
+      const std::vector<float> y(x.begin(), x.end());
+      error = std::max(error,
+                       relative_error(function->fitness(y) + 100.0 * i, fitness));
+    }
+    report_accuracy(function->get_name(), error);
+    EXPECT_LT(error, float_tolerance) << function->get_name();
+  }
+}
+
+TEST_F(CompositionFunctions, skipping_zero_weights_keeps_values) {
+  std::unique_ptr<DE::Problem::CECComposition<double>> function;
+  for (std::size_t i = 21; i <= 30; ++i) {
+    for (auto x : x_tests) {
+      initialize_function(function, i, x.size(), true);
+      for (int optimum = 0; optimum < 2; ++optimum) {
+        if (optimum) {  // The first shift, where the other weights vanish
+          FILE* fpt = fopen(shift_file(i).c_str(), "r");
+          ASSERT_NE(fpt, nullptr);
+          for (auto& v : x)
+            ASSERT_EQ(fscanf(fpt, "%lf", &v), 1);
+          fclose(fpt);
+        }
+        function->set_skip_zero_weights(true);
+        const double skipped = function->fitness(x);
+        function->set_skip_zero_weights(false);
+        EXPECT_EQ(function->fitness(x), skipped) << function->get_name();
+      }
+    }
+  }
+}
+
 }  // namespace
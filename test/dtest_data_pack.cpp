@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+#include <stdlib.h>
+#include <unistd.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "matrix.hpp"
+#include "rand.hpp"
+#include "problem/cec_data_pack.hpp"
+#include "problem/cec_basic_problem.hpp"
+#include "problem/rastrigin.hpp"
+#include "problem/hybrid_7.hpp"
+#include "problem/composition_1.hpp"
+#include "problem/composition_10.hpp"
+#include "test_utils.hpp"
+
+namespace {
+
+/*!
+ * Packs the data directory into a temporary directory, which holds no text
+ * files: the functions reading from it find their data in the pack only.
+ */
+class DataPack : public ::testing::Test {
+ protected:
+  DataPack() {
+    char name[] = "/tmp/dtest_data_pack_XXXXXX";
+    directory_ = std::string(mkdtemp(name)) + "/";
+    pack_ = directory_ + DE::Problem::CECDataPack::file_name;
+    DE::Problem::CECDataPack::create("cec-2017/", pack_);
+  }
+
+  ~DataPack() {
+    std::remove(pack_.c_str());
+    rmdir(directory_.c_str());
+  }
+
+  /*! The path to a data file within the temporary directory */
+  std::string packed(const std::string& file) const {
+    return directory_ + file.substr(file.rfind('/') + 1);
+  }
+
+  std::string directory_, pack_;
+};
+
+TEST_F(DataPack, same_values_as_text) {
+  DE::Problem::CECDataPack pack(pack_);
+  const std::size_t D = 30;
+  const auto* shift = pack.find("shift_data_21.txt");
+  const auto* rotation = pack.find("M_21_D30.txt");
+  const auto* shuffle = pack.find("shuffle_data_17_D30.txt");
+  ASSERT_TRUE(shift && rotation && shuffle);
+  EXPECT_FALSE(shift->rotation);
+  EXPECT_TRUE(rotation->rotation);
+  EXPECT_EQ(rotation->cols, D);
+  EXPECT_EQ(rotation->stride, DE::Matrix<double>::padded_size(D));
+  EXPECT_GE(shuffle->rows * shuffle->cols, D);
+
+  FILE* fpt = fopen(shift_file(21).c_str(), "r");
+  ASSERT_NE(fpt, nullptr);
+  for (std::size_t i = 0; i < shift->rows; ++i)
+    for (std::size_t j = 0; j < shift->cols; ++j) {
+      double value;
+      ASSERT_EQ(fscanf(fpt, "%lf", &value), 1);
+      EXPECT_EQ(shift->data[i * shift->stride + j], value);
+    }
+  fclose(fpt);
+
+  // Stored as transposed blocks of D rows
+  fpt = fopen(rotation_file(21, D).c_str(), "r");
+  ASSERT_NE(fpt, nullptr);
+  for (std::size_t i = 0; i < rotation->rows; ++i)
+    for (std::size_t j = 0; j < D; ++j) {
+      double value;
+      ASSERT_EQ(fscanf(fpt, "%lf", &value), 1);
+      const std::size_t block = i / D * D;
+      EXPECT_EQ(rotation->data[(block + j) * rotation->stride + i % D], value);
+    }
+  fclose(fpt);
+
+  fpt = fopen(shuffle_file(17, D).c_str(), "r");
+  ASSERT_NE(fpt, nullptr);
+  for (std::size_t i = 0; i < shuffle->rows * shuffle->cols; ++i) {
+    double value;
+    ASSERT_EQ(fscanf(fpt, "%lf", &value), 1);
+    EXPECT_EQ(shuffle->data[i], value);
+  }
+  fclose(fpt);
+}
+
+TEST_F(DataPack, same_fitness_as_text) {
+  using Function = DE::Problem::CECFunction<double>;
+  for (const std::size_t D : {10, 30}) {
+    std::vector<std::unique_ptr<Function>> text, mapped;
+    for (const bool from_pack : {false, true}) {
+      auto path = [&](const std::string& file) {
+        return from_pack ? packed(file) : file;
+      };
+      auto& f = from_pack ? mapped : text;
+      f.emplace_back(new DE::Problem::RastriginFunction<double>(D));
+      f.back()->parse_shift_file(path(shift_file(5)).c_str());
+      f.back()->parse_rotation_file(path(rotation_file(5, D)).c_str());
+      f.emplace_back(new DE::Problem::HybridFunction7<double>(
+          D, path(shuffle_file(17, D)).c_str()));
+      f.back()->parse_shift_file(path(shift_file(17)).c_str());
+      f.back()->parse_rotation_file(path(rotation_file(17, D)).c_str());
+      f.emplace_back(new DE::Problem::CompositionFunction1<double>(
+          D, path(shift_file(21)).c_str(), path(rotation_file(21, D)).c_str()));
+      f.emplace_back(new DE::Problem::CompositionFunction10<double>(
+          D, path(shift_file(30)).c_str(), path(rotation_file(30, D)).c_str(),
+          path(shuffle_file(30, D)).c_str()));
+    }
+    // The rotations point into the pack
+    const auto* table = DE::Problem::CECDataPack::open(directory_)->find(
+        "M_5_D" + std::to_string(D) + ".txt");
+    EXPECT_EQ(mapped[0]->get_rotation_data().data(), table->data);
+
+    std::vector<double> x(D);
+    for (std::size_t test = 0; test < 20; ++test) {
+      for (auto& v : x)
+        v = rand_uniform_real(-100, 100);
+      for (std::size_t i = 0; i < text.size(); ++i)
+        EXPECT_EQ(mapped[i]->fitness(x), text[i]->fitness(x))
+            << text[i]->get_name() << " " << D;
+    }
+  }
+}
+
+}  // namespace
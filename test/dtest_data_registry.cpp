@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "problem/cec_data_registry.hpp"
+#include "problem/rastrigin.hpp"
+#include "problem/hybrid_1.hpp"
+#include "test_utils.hpp"
+
+namespace {
+
+using Registry = DE::Problem::CECDataRegistry<double>;
+
+TEST(DataRegistry, functions_share_their_data) {
+  constexpr std::size_t D = 30;
+  DE::Problem::RastriginFunction<double> a(D), b(D);
+  for (auto* f : {&a, &b}) {
+    f->parse_shift_file(shift_file(5).c_str());
+    f->parse_rotation_file(rotation_file(5, D).c_str());
+  }
+  EXPECT_EQ(a.get_shift_data().data(), b.get_shift_data().data());
+  EXPECT_EQ(a.get_rotation_data().data(), b.get_rotation_data().data());
+
+  // Other rows of the same file are other data
+  b.parse_shift_file(shift_file(5).c_str(), 1);
+  EXPECT_NE(a.get_shift_data().data(), b.get_shift_data().data());
+  EXPECT_NE(a.get_shift_data()[0], b.get_shift_data()[0]);
+}
+
+TEST(DataRegistry, loaded_once_across_threads) {
+  constexpr std::size_t D = 10, threads = 8;
+  std::vector<const double*> shifts(threads), rotations(threads);
+  // Missing data throw, which must fail the test rather than terminate
+  std::vector<std::string> errors(threads);
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < threads; ++t)
+    workers.emplace_back([&, t] {
+      try {
+        DE::Problem::HybridFunction1<double> f(D, shuffle_file(11, D).c_str());
+        f.parse_shift_file(shift_file(11).c_str());
+        f.parse_rotation_file(rotation_file(11, D).c_str());
+        shifts[t] = f.get_shift_data().data();
+        rotations[t] = f.get_rotation_data().data();
+      } catch (const std::exception& e) {
+        errors[t] = e.what();
+      }
+    });
+  for (auto& w : workers)
+    w.join();
+  for (std::size_t t = 0; t < threads; ++t)
+    ASSERT_EQ(errors[t], "") << "thread " << t;
+  // The functions are gone, the registry still holds the data
+  for (std::size_t t = 1; t < threads; ++t) {
+    EXPECT_EQ(shifts[t], shifts[0]);
+    EXPECT_EQ(rotations[t], rotations[0]);
+  }
+}
+
+TEST(DataRegistry, handles_outlive_clear) {
+  constexpr std::size_t D = 10;
+  DE::Problem::RastriginFunction<double> f(D);
+  f.parse_rotation_file(rotation_file(5, D).c_str());
+  const auto handle = Registry::rotation(rotation_file(5, D), 0, D);
+  EXPECT_EQ(handle.get(), f.get_rotation_data().data());
+  Registry::clear();
+  EXPECT_EQ(Registry::size(), 0u);
+  const double expected = handle.get()[0];
+  EXPECT_EQ(f.get_rotation_data()[0][0], expected);
+  // Loaded again
+  const auto reloaded = Registry::rotation(rotation_file(5, D), 0, D);
+  EXPECT_NE(reloaded.get(), handle.get());
+  EXPECT_EQ(reloaded.get()[0], expected);
+}
+
+TEST(DataRegistry, failed_loads_are_not_held) {
+  Registry::clear();
+  EXPECT_THROW(Registry::shift("missing/shift_data_1.txt", 0, 10),
+               std::runtime_error);
+  EXPECT_EQ(Registry::size(), 0u);
+}
+
+TEST(DataRegistry, truncated_files_are_not_held) {
+  constexpr std::size_t D = 10;
+  Registry::clear();
+  const std::string file = testing::TempDir() + "truncated_shift.txt";
+  {
+    std::ofstream out(file);
+    for (std::size_t i = 0; i < D - 1; ++i)
+      out << i << " ";
+  }
+  EXPECT_THROW(Registry::shift(file, 0, D), std::runtime_error);
+  EXPECT_THROW(Registry::rotation(file, 0, D), std::runtime_error);
+  EXPECT_THROW(Registry::shuffle(file, 0, D), std::runtime_error);
+  EXPECT_EQ(Registry::size(), 0u);
+  // Enough values for a shift of D - 1 genes
+  EXPECT_EQ(Registry::shift(file, 0, D - 1).get()[D - 2], double(D - 2));
+  std::remove(file.c_str());
+}
+
+}  // namespace
@@ -0,0 +1,30 @@
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <type_traits>
+#include "dimension.hpp"
+
+namespace {
+
+TEST(Dimension, known_at_compile_time_for_the_cec_dimensions) {
+  for (const std::size_t D : {2, 10, 11, 30, 50, 64, 100}) {
+    const bool constant = DE::with_dimension(D, [&](const auto dim) {
+      EXPECT_EQ(std::size_t(dim), D);
+      return !std::is_same<std::decay_t<decltype(dim)>, std::size_t>::value;
+    });
+    EXPECT_EQ(constant, D == 10 || D == 30 || D == 50 || D == 100) << D;
+  }
+}
+
+TEST(Dimension, gene_buffers_are_padded) {
+  for (const std::size_t D : {7, 10, 30}) {
+    DE::with_dimension(D, [&](const auto dim) {
+      DE::GeneBuffer<double, decltype(dim)> buffer(dim);
+      EXPECT_EQ(buffer.size(), DE::Matrix<double>::padded_size(D));
+      if (D != 7) {  // On the stack
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer.data()) % 64, 0u);
+      }
+    });
+  }
+}
+
+}  // namespace
@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "executor.hpp"
+#include "problem/griewank.hpp"
+#include "algorithm/shade.hpp"
+#include "algorithm/degl.hpp"
+
+namespace {
+
+/*! Count how many times every index of [0, n) is visited */
+std::vector<int> visits(DE::Executor& executor, const std::size_t n) {
+  std::vector<std::atomic<int>> counts(n);
+  for (auto& c : counts)
+    c = 0;
+  executor.parallel_for(n, [&counts](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      ++counts[i];
+  });
+  return std::vector<int>(counts.begin(), counts.end());
+}
+
+TEST(Executor, serial_runs_inline) {
+  DE::SerialExecutor executor;
+  EXPECT_EQ(executor.num_threads(), 1u);
+  const auto caller = std::this_thread::get_id();
+  executor.parallel_for(10, [caller](std::size_t begin, std::size_t end) {
+    EXPECT_EQ(std::this_thread::get_id(), caller);
+    EXPECT_EQ(begin, 0u);
+    EXPECT_EQ(end, 10u);
+  });
+}
+
+TEST(Executor, pool_visits_every_index_once) {
+  for (const std::size_t threads : {1, 2, 3, 8}) {
+    for (const std::size_t chunk : {0, 1, 7, 1000}) {
+      DE::ThreadPoolExecutor executor(threads, chunk);
+      EXPECT_EQ(executor.num_threads(), threads);
+      for (const std::size_t n : {0, 1, 5, 100, 1001}) {
+        // Many loops in a row reuse the same workers
+        for (std::size_t repeat = 0; repeat < 20; ++repeat)
+          EXPECT_EQ(visits(executor, n), std::vector<int>(n, 1))
+              << threads << " threads, chunk " << chunk << ", n " << n;
+      }
+    }
+  }
+}
+
+TEST(Executor, chunk_size) {
+  DE::ThreadPoolExecutor executor(4);
+  EXPECT_EQ(executor.chunk_size(160), 10u);
+  EXPECT_EQ(executor.chunk_size(1), 1u);
+  executor.set_chunk_size(3);
+  EXPECT_EQ(executor.chunk_size(160), 3u);
+  executor.parallel_for(10, [](std::size_t begin, std::size_t end) {
+    EXPECT_EQ(begin % 3, 0u);
+    EXPECT_LE(end - begin, 3u);
+  });
+}
+
+TEST(Executor, exceptions_reach_the_caller) {
+  DE::ThreadPoolExecutor executor(4, 1);
+  EXPECT_THROW(executor.parallel_for(
+                   100,
+                   [](std::size_t begin, std::size_t) {
+                     if (begin == 42)
+                       throw std::runtime_error("chunk failed");
+                   }),
+               std::runtime_error);
+  // The pool is still usable afterwards
+  EXPECT_EQ(visits(executor, 100), std::vector<int>(100, 1));
+}
+
+TEST(Executor, nested_loops_run_inline) {
+  constexpr std::size_t n = 64, m = 50;
+  DE::ThreadPoolExecutor executor(4, 1);
+  std::vector<std::atomic<int>> counts(n * m);
+  for (auto& c : counts)
+    c = 0;
+  executor.parallel_for(n, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      const auto thread = std::this_thread::get_id();
+      executor.parallel_for(m, [&, i, thread](std::size_t b, std::size_t e) {
+        EXPECT_EQ(std::this_thread::get_id(), thread);
+        for (std::size_t j = b; j < e; ++j)
+          ++counts[i * m + j];
+      });
+    }
+  });
+  EXPECT_EQ(std::vector<int>(counts.begin(), counts.end()),
+            std::vector<int>(n * m, 1));
+}
+
+TEST(Executor, concurrent_callers_take_turns) {
+  constexpr std::size_t callers = 4, loops = 200, n = 97;
+  DE::ThreadPoolExecutor executor(3, 2);
+  std::atomic<std::size_t> failures{0};
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < callers; ++t)
+    threads.emplace_back([&] {
+      for (std::size_t l = 0; l < loops; ++l)
+        if (visits(executor, n) != std::vector<int>(n, 1))
+          ++failures;
+    });
+  for (auto& thread : threads)
+    thread.join();
+  EXPECT_EQ(failures, 0u);
+}
+
+/*! Griewank's function recording the batches it evaluates */
+class RecordingGriewank : public DE::Problem::GriewankFunction<double> {
+ public:
+  using DE::Problem::GriewankFunction<double>::GriewankFunction;
+
+  void fitness_batch(DE::ConstBlockView<double> chromosomes,
+                     double* fitness) const {
+    GriewankFunction<double>::fitness_batch(chromosomes, fitness);
+    batches += 1;
+    rows += chromosomes.rows();
+  }
+
+  mutable std::atomic<std::size_t> batches{0}, rows{0};
+};
+
+TEST(Executor, initial_population_in_chunks) {
+  constexpr std::size_t D = 10, N = 18 * D;
+  auto problem = std::make_shared<RecordingGriewank>(D);
+  DE::Algorithm::SHADE<double> shade(
+      problem, false, true, std::make_shared<DE::ThreadPoolExecutor>(4, 16));
+  EXPECT_EQ(problem->batches, (N + 15) / 16);
+  EXPECT_EQ(problem->rows, N);
+  const auto best = shade.get_best();
+  EXPECT_EQ(problem->fitness(best.best_chromosome), best.best_fitness);
+}
+
+TEST(Executor, shade_with_pool) {
+  constexpr std::size_t D = 10;
+  auto executor = std::make_shared<DE::ThreadPoolExecutor>(4);
+  DE::Algorithm::SHADE<double> shade(
+      std::make_shared<DE::Problem::GriewankFunction<double>>(D), false, true,
+      executor);
+  EXPECT_EQ(&shade.get_executor(), executor.get());
+  const double initial = shade.get_best().best_fitness;
+  shade.evolve_population(50);
+  EXPECT_LE(shade.get_best().best_fitness, initial);
+}
+
+TEST(Executor, degl_with_pool) {
+  constexpr std::size_t D = 10;
+  auto executor = std::make_shared<DE::ThreadPoolExecutor>(4, 3);
+  DE::Algorithm::DEGL<double> degl(
+      std::make_shared<DE::Problem::GriewankFunction<double>>(D), true,
+      executor);
+  EXPECT_EQ(&degl.get_executor(), executor.get());
+  const double initial = degl.get_best().best_fitness;
+  degl.evolve_population(50);
+  EXPECT_LE(degl.get_best().best_fitness, initial);
+}
+
+}  // namespace
@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 #include <memory>
+#include <vector>
+#include "rand.hpp"
 #include "problem/cec_hybrid_function.hpp"
 #include "problem/hybrid_1.hpp"
 #include "problem/hybrid_2.hpp"
@@ -14,49 +16,50 @@
 #include "test_utils.hpp"
 #include "cec17_test_func.hpp"
 
+template <class T>
 void initialize_function(
-    std::unique_ptr<DE::Problem::CECHybrid<double>>& function,
+    std::unique_ptr<DE::Problem::CECHybrid<T>>& function,
     const std::size_t num,
     const std::size_t D) {
   switch (num) {
     case 11:
-      function = std::make_unique<DE::Problem::HybridFunction1>(
+      function = std::make_unique<DE::Problem::HybridFunction1<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 12:
-      function = std::make_unique<DE::Problem::HybridFunction2>(
+      function = std::make_unique<DE::Problem::HybridFunction2<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 13:
-      function = std::make_unique<DE::Problem::HybridFunction3>(
+      function = std::make_unique<DE::Problem::HybridFunction3<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 14:
-      function = std::make_unique<DE::Problem::HybridFunction4>(
+      function = std::make_unique<DE::Problem::HybridFunction4<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 15:
-      function = std::make_unique<DE::Problem::HybridFunction5>(
+      function = std::make_unique<DE::Problem::HybridFunction5<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 16:
-      function = std::make_unique<DE::Problem::HybridFunction6>(
+      function = std::make_unique<DE::Problem::HybridFunction6<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 17:
-      function = std::make_unique<DE::Problem::HybridFunction7>(
+      function = std::make_unique<DE::Problem::HybridFunction7<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 18:
-      function = std::make_unique<DE::Problem::HybridFunction8>(
+      function = std::make_unique<DE::Problem::HybridFunction8<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 19:
-      function = std::make_unique<DE::Problem::HybridFunction9>(
+      function = std::make_unique<DE::Problem::HybridFunction9<T>>(
           D, shuffle_file(num, D).c_str());
       break;
     case 20:
-      function = std::make_unique<DE::Problem::HybridFunction10>(
+      function = std::make_unique<DE::Problem::HybridFunction10<T>>(
           D, shuffle_file(num, D).c_str());
       break;
   }
@@ -84,4 +87,43 @@ TEST_F(HybridFunctions, same_values_shifted) {
   }
 }
 
+TEST_F(HybridFunctions, float_accuracy) {
+  std::unique_ptr<DE::Problem::CECHybrid<float>> function;
+  double fitness;
+  for (std::size_t i = 11; i <= 20; ++i) {
+    double error = 0.0;
+    for (auto& x : x_tests) {
+      initialize_function(function, i, x.size());
+      function->parse_shift_file(shift_file(i).c_str());
+      function->parse_rotation_file(rotation_file(i, x.size()).c_str());
+      cec17_test_func(x.data(), &fitness, x.size(), 1, i);
+      const std::vector<float> y(x.begin(), x.end());
+      error = std::max(error,
+                       relative_error(function->fitness(y) + 100.0 * i, fitness));
+    }
+    report_accuracy(function->get_name(), error);
+    EXPECT_LT(error, float_tolerance) << function->get_name();
+  }
+}
+
+TEST_F(HybridFunctions, without_shuffle_file_genes_keep_their_order) {
+  // Hybrid function 1 is Zakharov, Rosenbrock and Rastrigin on 20%, 40% and
+  // 40% of the genes, in order
+  constexpr std::size_t D = 10;
+  DE::Problem::HybridFunction1<double> hybrid(D);
+  DE::Problem::ZakharovFunction<double> zakharov(2);
+  DE::Problem::RosenbrockFunction<double> rosenbrock(4);
+  DE::Problem::RastriginFunction<double> rastrigin(4);
+  std::vector<double> x(D);
+  for (std::size_t test = 0; test < 20; ++test) {
+    for (auto& v : x)
+      v = rand_uniform_real(-100, 100);
+    const double expected =
+        zakharov.fitness({x[0], x[1]}) +
+        rosenbrock.fitness({x[2], x[3], x[4], x[5]}) +
+        rastrigin.fitness({x[6], x[7], x[8], x[9]});
+    EXPECT_DOUBLE_EQ(hybrid.fitness(x), expected);
+  }
+}
+
 }  // namespace
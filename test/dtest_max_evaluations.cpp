@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+#include <memory>
+#include <thread>
+#include <vector>
+#include "executor.hpp"
+#include "problem/counting_problem.hpp"
+#include "problem/griewank.hpp"
+#include "algorithm/shade.hpp"
+#include "algorithm/degl.hpp"
+
+namespace {
+
+using Counting = DE::Problem::CountingProblem<double>;
+using Optimizer = DE::Algorithm::Base<double>;
+
+enum class Algorithm { shade, lshade, degl };
+
+std::unique_ptr<Optimizer> make_optimizer(
+    const Algorithm algorithm,
+    std::shared_ptr<DE::Problem::Base<double>> problem,
+    std::shared_ptr<DE::Executor> executor) {
+  constexpr std::size_t run = 11;
+  switch (algorithm) {
+    case Algorithm::shade:
+      return std::make_unique<DE::Algorithm::SHADE<double>>(
+          problem, false, true, executor, run);
+    case Algorithm::lshade:
+      return std::make_unique<DE::Algorithm::SHADE<double>>(problem, true, true,
+                                                            executor, run);
+    default:
+      return std::make_unique<DE::Algorithm::DEGL<double>>(problem, true,
+                                                           executor, run);
+  }
+}
+
+std::shared_ptr<Counting> counting_griewank(const std::size_t D) {
+  return std::make_shared<Counting>(
+      std::make_shared<DE::Problem::GriewankFunction<double>>(D));
+}
+
+TEST(MaxEvaluations, counting_problem_forwards_and_counts) {
+  constexpr std::size_t D = 10;
+  const auto griewank =
+      std::make_shared<DE::Problem::GriewankFunction<double>>(D);
+  Counting counting(griewank);
+  EXPECT_EQ(counting.get_number_of_genes(), D);
+  EXPECT_EQ(&counting.get_problem(), griewank.get());
+
+  DE::Matrix<double> x(5, D);
+  counting.randomize_batch(x);
+  std::vector<double> fitness(5);
+  counting.fitness_batch(x, fitness.data());
+  EXPECT_EQ(counting.get_evaluations(), 5u);
+  EXPECT_EQ(counting.fitness(x[2]), griewank->fitness(x[2]));
+  EXPECT_EQ(fitness[2], griewank->fitness(x[2]));
+  EXPECT_EQ(counting.get_evaluations(), 6u);
+
+  // From several threads at once
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 4; ++t)
+    threads.emplace_back([&] {
+      for (std::size_t i = 0; i < 100; ++i)
+        counting.fitness(x[i % 5]);
+    });
+  for (auto& t : threads)
+    t.join();
+  EXPECT_EQ(counting.get_evaluations(), 406u);
+  counting.reset();
+  EXPECT_EQ(counting.get_evaluations(), 0u);
+}
+
+TEST(MaxEvaluations, limit_is_exact_mid_generation) {
+  constexpr std::size_t D = 10;
+  for (const auto algorithm :
+       {Algorithm::shade, Algorithm::lshade, Algorithm::degl}) {
+    for (const std::size_t threads : {1, 4}) {
+      const auto problem = counting_griewank(D);
+      const auto optimizer = make_optimizer(
+          algorithm, problem,
+          std::make_shared<DE::ThreadPoolExecutor>(threads, 7));
+      const std::size_t N = problem->get_evaluations();
+      EXPECT_EQ(optimizer->get_evaluations(), N);
+      // Not a whole number of generations
+      const std::size_t limit = 5 * N + 37;
+      optimizer->set_max_evaluations(limit);
+      optimizer->evolve_population(1000);
+      EXPECT_EQ(problem->get_evaluations(), limit) << threads;
+      EXPECT_EQ(optimizer->get_evaluations(), limit) << threads;
+      // Nothing is left to evolve
+      optimizer->evolve_population(1000);
+      EXPECT_EQ(problem->get_evaluations(), limit) << threads;
+    }
+  }
+}
+
+TEST(MaxEvaluations, same_results_with_any_executor) {
+  constexpr std::size_t D = 10;
+  for (const auto algorithm :
+       {Algorithm::shade, Algorithm::lshade, Algorithm::degl}) {
+    std::vector<double> best;
+    for (const std::size_t threads : {1, 3, 4}) {
+      const auto optimizer =
+          make_optimizer(algorithm, counting_griewank(D),
+                         std::make_shared<DE::ThreadPoolExecutor>(threads, 5));
+      optimizer->set_max_evaluations(2000 + 19);
+      optimizer->evolve_population(100);
+      best.push_back(optimizer->get_best().best_fitness);
+    }
+    EXPECT_EQ(best[1], best[0]);
+    EXPECT_EQ(best[2], best[0]);
+  }
+}
+
+TEST(MaxEvaluations, no_limit_by_default) {
+  constexpr std::size_t D = 10, N = 18 * D, G = 20;
+  const auto problem = counting_griewank(D);
+  DE::Algorithm::SHADE<double> shade(problem);
+  shade.evolve_population(G);
+  EXPECT_EQ(problem->get_evaluations(), N * (G + 1));
+  EXPECT_EQ(shade.get_evaluations(), N * (G + 1));
+}
+
+TEST(MaxEvaluations, limit_below_the_population) {
+  constexpr std::size_t D = 10, N = 10 * D;
+  const auto problem = counting_griewank(D);
+  DE::Algorithm::DEGL<double> degl(problem);
+  const double initial = degl.get_best().best_fitness;
+  degl.set_max_evaluations(N / 2);
+  degl.evolve_population(20);
+  // The initial population was evaluated in full by the constructor, past
+  // the limit, and no generation runs
+  EXPECT_EQ(problem->get_evaluations(), N);
+  EXPECT_EQ(degl.get_best().best_fitness, initial);
+}
+
+}  // namespace
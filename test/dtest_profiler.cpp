@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#define DE_PROFILE_PHASES
+#include "profiler.hpp"
+#include "timer.hpp"
+
+namespace {
+
+using DE::Phase;
+using DE::PhaseProfiler;
+
+void mutate_for(const std::chrono::microseconds duration) {
+  DE_PROFILE_PHASE(mutation);
+  std::this_thread::sleep_for(duration);
+}
+
+TEST(Profiler, sums_the_phases_of_every_thread) {
+  PhaseProfiler::reset();
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 4; ++t)
+    threads.emplace_back([] {
+      for (std::size_t i = 0; i < 3; ++i)
+        mutate_for(std::chrono::microseconds(100));
+    });
+  for (auto& t : threads)
+    t.join();
+  {
+    DE_PROFILE_PHASE(archive);
+  }
+  // The threads are gone, their times remain
+  const auto totals = PhaseProfiler::totals();
+  const auto mutation = std::size_t(Phase::mutation);
+  EXPECT_EQ(totals.calls[mutation], 12u);
+  EXPECT_GE(totals.nanoseconds[mutation], 12u * 100000u);
+  EXPECT_EQ(totals.calls[std::size_t(Phase::archive)], 1u);
+  EXPECT_EQ(totals.calls[std::size_t(Phase::crossover)], 0u);
+  EXPECT_EQ(totals.nanoseconds[std::size_t(Phase::crossover)], 0u);
+
+  PhaseProfiler::reset();
+  EXPECT_EQ(PhaseProfiler::totals().calls[mutation], 0u);
+  EXPECT_EQ(PhaseProfiler::totals().nanoseconds[mutation], 0u);
+}
+
+TEST(Profiler, phases_have_names) {
+  EXPECT_STREQ(DE::name(Phase::top_p), "update_top_p_solutions");
+  EXPECT_STREQ(DE::name(Phase::size_reduction), "linear_size_reduction");
+  EXPECT_STREQ(DE::name(Phase::repair), "constrain_trial");
+  EXPECT_STREQ(DE::name(Phase::selection), "select");
+}
+
+TEST(Profiler, inner_phases_are_not_counted_twice) {
+  PhaseProfiler::reset();
+  {
+    DE_PROFILE_PHASE(mutation);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    {
+      DE_PROFILE_PHASE(repair);
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+  }
+  const auto totals = PhaseProfiler::totals();
+  const auto mutation = totals.nanoseconds[std::size_t(Phase::mutation)];
+  EXPECT_GE(totals.nanoseconds[std::size_t(Phase::repair)], 20000000u);
+  EXPECT_GE(mutation, 2000000u);
+  EXPECT_LT(mutation, 20000000u);
+  EXPECT_EQ(totals.calls[std::size_t(Phase::mutation)], 1u);
+  PhaseProfiler::reset();
+}
+
+TEST(Profiler, run_summary) {
+  {
+    DE_PROFILE_PHASE(crossover);  // Before the run, not in its summary
+  }
+  const DE::ProfiledRun run;
+  for (std::size_t i = 0; i < 3; ++i)
+    mutate_for(std::chrono::microseconds(1000));
+  const auto summary = run.summary();
+  EXPECT_EQ(summary.totals.calls[std::size_t(Phase::mutation)], 3u);
+  EXPECT_EQ(summary.totals.calls[std::size_t(Phase::crossover)], 0u);
+  EXPECT_GE(summary.wall_nanoseconds,
+            summary.totals.nanoseconds[std::size_t(Phase::mutation)]);
+  EXPECT_GT(summary.share(Phase::mutation), 0.5);
+  EXPECT_LE(summary.share(Phase::mutation), 1.0);
+
+  std::ostringstream table;
+  summary.write_table(table);
+  EXPECT_EQ(0u, table.str().find("phase"));
+  EXPECT_NE(std::string::npos, table.str().find("\nmutate "));
+  EXPECT_EQ(std::string::npos, table.str().find("crossover"));
+  EXPECT_NE(std::string::npos, table.str().find("\nwall "));
+
+  std::ostringstream json;
+  summary.write_json(json);
+  const std::string s = json.str();
+  EXPECT_EQ(0u, s.find("{\"wall_ns\": "));
+  EXPECT_NE(std::string::npos,
+            s.find("{\"name\": \"mutate\", \"calls\": 3, \"ns\": "));
+  EXPECT_NE(std::string::npos,
+            s.find("{\"name\": \"crossover\", \"calls\": 0, \"ns\": 0"));
+  EXPECT_EQ("]}", s.substr(s.size() - 2));
+}
+
+#ifdef DE_HAS_TSC
+TEST(Profiler, tsc_clock_keeps_time) {
+  const BasicTimer<TscClock> tsc;
+  const Timer reference;
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  const double ratio =
+      double(tsc.elapsed().count()) / reference.elapsed().count();
+  EXPECT_GT(ratio, 0.9);
+  EXPECT_LT(ratio, 1.1);
+}
+#endif
+
+}  // namespace
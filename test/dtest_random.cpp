@@ -0,0 +1,188 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "rand.hpp"
+#include "executor.hpp"
+#include "problem/rastrigin.hpp"
+#include "algorithm/shade.hpp"
+#include "algorithm/degl.hpp"
+
+namespace {
+
+TEST(Random, philox_known_answers) {
+  // Known-answer tests of Random123 for Philox-4x32-10
+  using P = Philox4x32;
+  EXPECT_EQ(P::generate({{0, 0, 0, 0}}, {{0, 0}}),
+            (P::counter_type{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}));
+  EXPECT_EQ(P::generate({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+                        {{0xffffffff, 0xffffffff}}),
+            (P::counter_type{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}));
+  EXPECT_EQ(P::generate({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+                        {{0xa4093822, 0x299f31d0}}),
+            (P::counter_type{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}));
+}
+
+TEST(Random, streams_are_independent) {
+  const RandomStreamKey key{42, 1, 2, 3, RandomPurpose::trial};
+  Philox4x32 a(key), b(key);
+  for (std::size_t i = 0; i < 100; ++i)
+    EXPECT_EQ(a(), b());
+  for (auto other : {RandomStreamKey{43, 1, 2, 3, RandomPurpose::trial},
+                     RandomStreamKey{42, 0, 2, 3, RandomPurpose::trial},
+                     RandomStreamKey{42, 1, 3, 3, RandomPurpose::trial},
+                     RandomStreamKey{42, 1, 2, 4, RandomPurpose::trial},
+                     RandomStreamKey{42, 1, 2, 3, RandomPurpose::selection}}) {
+    Philox4x32 c(key), d(other);
+    std::size_t equal = 0;
+    for (std::size_t i = 0; i < 100; ++i)
+      equal += c() == d();
+    EXPECT_LT(equal, 2u);
+  }
+}
+
+TEST(Random, scoped_streams_nest) {
+  const RandomStreamKey outer{1, 0, 0, 0, RandomPurpose::trial},
+      inner{1, 0, 0, 1, RandomPurpose::trial};
+  double expected_outer[2], expected_inner;
+  {
+    ScopedRandomStream s(outer);
+    expected_outer[0] = rand_uniform_real(0, 1);
+    expected_outer[1] = rand_uniform_real(0, 1);
+  }
+  {
+    ScopedRandomStream s(inner);
+    expected_inner = rand_uniform_real(0, 1);
+  }
+  ScopedRandomStream s(outer);
+  EXPECT_EQ(rand_uniform_real(0, 1), expected_outer[0]);
+  {
+    ScopedRandomStream t(inner);
+    EXPECT_EQ(rand_uniform_real(0, 1), expected_inner);
+  }
+  EXPECT_EQ(rand_uniform_real(0, 1), expected_outer[1]);
+}
+
+TEST(Random, fill_matches_single_draws) {
+  const RandomStreamKey key{5, 0, 0, 0, RandomPurpose::trial};
+  for (std::size_t n : {1u, 7u, 8u, 33u, 300u}) {
+    Philox4x32 a(key), b(key);
+    std::vector<std::uint32_t> bulk(n);
+    a.fill(bulk.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+      EXPECT_EQ(bulk[i], b());
+    EXPECT_EQ(a(), b());  // Both continue from the same position
+  }
+}
+
+/*! Mean and variance of n samples */
+std::pair<double, double> moments(const std::vector<double>& x) {
+  double mean = 0, variance = 0;
+  for (auto v : x)
+    mean += v;
+  mean /= x.size();
+  for (auto v : x)
+    variance += (v - mean) * (v - mean);
+  return {mean, variance / (x.size() - 1)};
+}
+
+TEST(Random, bulk_distributions) {
+  ScopedRandomStream stream({9, 0, 0, 0, RandomPurpose::trial});
+  constexpr std::size_t n = 100000;
+  std::vector<double> x(n);
+
+  fill_uniform_real(x.data(), n, -1, 3);
+  for (auto v : x) {
+    EXPECT_GE(v, -1);
+    EXPECT_LT(v, 3);
+  }
+  auto m = moments(x);
+  EXPECT_NEAR(m.first, 1, 0.05);
+  EXPECT_NEAR(m.second, 16.0 / 12, 0.05);
+
+  fill_normal(x.data(), n, 2, 0.5);
+  m = moments(x);
+  EXPECT_NEAR(m.first, 2, 0.01);
+  EXPECT_NEAR(m.second, 0.25, 0.01);
+
+  // The Cauchy distribution has no moments; check its quartiles instead
+  fill_cauchy(x.data(), n, 0.5, 0.1);
+  std::sort(x.begin(), x.end());
+  EXPECT_NEAR(x[n / 4], 0.4, 0.005);
+  EXPECT_NEAR(x[n / 2], 0.5, 0.005);
+  EXPECT_NEAR(x[3 * n / 4], 0.6, 0.005);
+}
+
+TEST(Random, scalar_cauchy_quartiles) {
+  ScopedRandomStream stream({10, 0, 0, 0, RandomPurpose::trial});
+  constexpr std::size_t n = 20000;
+  std::vector<double> x(n);
+  for (auto& v : x)
+    v = rand_cauchy(0.5, 0.1);
+  std::sort(x.begin(), x.end());
+  EXPECT_NEAR(x[n / 4], 0.4, 0.01);
+  EXPECT_NEAR(x[n / 2], 0.5, 0.01);
+  EXPECT_NEAR(x[3 * n / 4], 0.6, 0.01);
+}
+
+TEST(Random, crossover_mask_rate) {
+  ScopedRandomStream stream({11, 0, 0, 0, RandomPurpose::trial});
+  constexpr std::size_t n = 100000;
+  std::vector<std::uint8_t> mask(n);
+  for (float Cr : {0.0f, 0.1f, 0.5f, 0.9f, 1.0f}) {
+    fill_crossover_mask(mask.data(), n, Cr);
+    std::size_t ones = 0;
+    for (auto b : mask)
+      ones += b != 0;
+    EXPECT_NEAR(double(ones) / n, Cr, 0.01);
+  }
+}
+
+TEST(Random, uniform_index_covers_range) {
+  ScopedRandomStream stream({12, 0, 0, 0, RandomPurpose::trial});
+  std::vector<std::size_t> counts(7, 0);
+  for (std::size_t i = 0; i < 70000; ++i)
+    ++counts[uniform_index(random_engine()(), counts.size())];
+  for (auto c : counts)
+    EXPECT_NEAR(c, 10000, 500);
+}
+
+/*! Best chromosome after a few generations of every algorithm */
+template <class Algorithm, class... Args>
+std::vector<double> evolve(std::shared_ptr<DE::Executor> executor,
+                           Args... args) {
+  constexpr std::size_t D = 10;
+  Algorithm algorithm(
+      std::make_shared<DE::Problem::RastriginFunction<double>>(D), args...,
+      true, executor, 7);
+  algorithm.evolve_population(30);
+  auto best = algorithm.get_best();
+  best.best_chromosome.push_back(best.best_fitness);
+  return best.best_chromosome;
+}
+
+TEST(Random, same_results_with_any_number_of_threads) {
+  using SHADE = DE::Algorithm::SHADE<double>;
+  using DEGL = DE::Algorithm::DEGL<double>;
+  const auto shade = evolve<SHADE>(nullptr, false);
+  const auto l_shade = evolve<SHADE>(nullptr, true);
+  const auto degl = evolve<DEGL>(nullptr);
+  for (const std::size_t threads : {2, 3, 8}) {
+    for (const std::size_t chunk : {1, 5, 0}) {
+      auto executor = std::make_shared<DE::ThreadPoolExecutor>(threads, chunk);
+      EXPECT_EQ(evolve<SHADE>(executor, false), shade);
+      EXPECT_EQ(evolve<SHADE>(executor, true), l_shade);
+      EXPECT_EQ(evolve<DEGL>(executor), degl);
+    }
+  }
+}
+
+TEST(Random, runs_differ) {
+  constexpr std::size_t D = 10;
+  auto f = std::make_shared<DE::Problem::RastriginFunction<double>>(D);
+  DE::Algorithm::SHADE<double> a(f), b(f);
+  EXPECT_NE(a.get_best().best_chromosome, b.get_best().best_chromosome);
+}
+
+}  // namespace
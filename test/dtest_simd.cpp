@@ -0,0 +1,241 @@
+#include "gtest/gtest.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "rand.hpp"
+#include "simd.hpp"
+#include "problem/cec_basic_problem.hpp"
+#include "problem/rastrigin.hpp"
+#include "problem/rastrigin_non_continuous_rotated.hpp"
+#include "problem/lunacek_bi_rastrigin.hpp"
+#include "problem/levy.hpp"
+#include "problem/modified_schwefel.hpp"
+#include "problem/ackley.hpp"
+#include "problem/griewank.hpp"
+#include "problem/expanded_griewank_plus_rosenbrock.hpp"
+#include "cec17_test_func.hpp"
+
+namespace {
+
+using DE::SIMD::InstructionSet;
+
+/*! Restores the detected instruction set at the end of a test */
+class SIMD : public ::testing::Test {
+ protected:
+  SIMD() : y_(100), z_(100), old_y_(y), old_z_(z) {
+    // Buffers of the reference functions
+    y = y_.data();
+    z = z_.data();
+  }
+
+  ~SIMD() {
+    DE::SIMD::set_instruction_set(InstructionSet::avx512);
+    y = old_y_;
+    z = old_z_;
+  }
+
+  std::vector<double> y_, z_;
+  double *old_y_, *old_z_;
+
+  /*! Every instruction set the CPU supports, from the narrowest */
+  std::vector<InstructionSet> instruction_sets() const {
+    std::vector<InstructionSet> sets;
+    for (auto isa : {InstructionSet::scalar, InstructionSet::sse2,
+                     InstructionSet::avx2, InstructionSet::avx512})
+      if (isa <= DE::SIMD::detect_instruction_set())
+        sets.push_back(isa);
+    return sets;
+  }
+
+  /*! Distance in ulp between two doubles of the same sign */
+  static std::int64_t ulp(const double a, const double b) {
+    std::int64_t x, y;
+    std::memcpy(&x, &a, sizeof(x));
+    std::memcpy(&y, &b, sizeof(y));
+    return x > y ? x - y : y - x;
+  }
+};
+
+TEST_F(SIMD, set_instruction_set) {
+  const auto detected = DE::SIMD::detect_instruction_set();
+  for (auto isa : instruction_sets()) {
+    EXPECT_EQ(DE::SIMD::set_instruction_set(isa), isa);
+    EXPECT_EQ(DE::SIMD::instruction_set(), isa);
+    EXPECT_EQ(DE::SIMD::enabled(), isa != InstructionSet::scalar);
+  }
+  EXPECT_EQ(DE::SIMD::set_instruction_set(InstructionSet::avx512), detected);
+}
+
+TEST_F(SIMD, sine_cosine_ulp) {
+  constexpr std::size_t n = 10001;  // Not a multiple of any width
+  std::vector<double> x(n), s(n), c(n);
+  for (auto isa : instruction_sets()) {
+    DE::SIMD::set_instruction_set(isa);
+    for (const double range :
+         {M_PI / 4, 10.0, 1e3, DE::SIMD::sine_cosine_limit}) {
+      for (auto& v : x)
+        v = rand_uniform_real(-range, range);
+      DE::SIMD::kernels().sin(x.data(), s.data(), n);
+      DE::SIMD::kernels().cos(x.data(), c.data(), n);
+      for (std::size_t i = 0; i < n; ++i) {
+        // libm is within 1 ulp, the kernels within 1.5 ulp
+        EXPECT_LE(ulp(s[i], std::sin(x[i])), 1) << x[i];
+        EXPECT_LE(ulp(c[i], std::cos(x[i])), 1) << x[i];
+      }
+    }
+  }
+}
+
+TEST_F(SIMD, sine_cosine_special_values) {
+  const std::vector<double> x = {0.0,
+                                 -0.0,
+                                 M_PI / 2,
+                                 M_PI,
+                                 1e5 * M_PI,
+                                 DE::SIMD::sine_cosine_limit,
+                                 -2 * DE::SIMD::sine_cosine_limit,
+                                 1e300,
+                                 std::numeric_limits<double>::infinity(),
+                                 std::numeric_limits<double>::quiet_NaN()};
+  std::vector<double> s(x.size()), c(x.size());
+  for (auto isa : instruction_sets()) {
+    DE::SIMD::set_instruction_set(isa);
+    DE::SIMD::kernels().sin(x.data(), s.data(), x.size());
+    DE::SIMD::kernels().cos(x.data(), c.data(), x.size());
+    EXPECT_EQ(s[0], 0.0);
+    EXPECT_TRUE(std::signbit(s[1]));
+    EXPECT_EQ(c[0], 1.0);
+    // Next to the zeros the error is absolute, 2^-60 |x| at most
+    EXPECT_NEAR(c[2], std::cos(x[2]), 1e-16);
+    EXPECT_NEAR(s[3], std::sin(x[3]), 1e-16);
+    EXPECT_NEAR(s[4], std::sin(x[4]), 1e-12);
+    EXPECT_EQ(s[5], std::sin(x[5]));
+    // Delegated to libm
+    for (std::size_t i = 6; i < 8; ++i) {
+      EXPECT_EQ(s[i], std::sin(x[i]));
+      EXPECT_EQ(c[i], std::cos(x[i]));
+    }
+    EXPECT_TRUE(std::isnan(s[8]) && std::isnan(c[8]));
+    EXPECT_TRUE(std::isnan(s[9]) && std::isnan(c[9]));
+  }
+}
+
+TEST_F(SIMD, same_values_as_reference) {
+  using Function = DE::Problem::CECFunction<double>;
+  using Reference = void (*)(double*, double*, int, double*, double*, int, int);
+  const Reference references[] = {rastrigin_func, levy_func, schwefel_func,
+                                  ackley_func, griewank_func};
+  for (auto isa : instruction_sets()) {
+    DE::SIMD::set_instruction_set(isa);
+    for (const std::size_t D : {7, 10, 13, 30, 50, 100}) {
+      std::unique_ptr<Function> functions[] = {
+          std::make_unique<DE::Problem::RastriginFunction<double>>(D),
+          std::make_unique<DE::Problem::LevyFunction<double>>(D),
+          std::make_unique<DE::Problem::SchwefelFunction<double>>(D),
+          std::make_unique<DE::Problem::AckleyFunction<double>>(D),
+          std::make_unique<DE::Problem::GriewankFunction<double>>(D)};
+      std::vector<double> x(D);
+      double reference;
+      for (std::size_t f = 0; f < 5; ++f) {
+        for (std::size_t test = 0; test < 20; ++test) {
+          for (auto& v : x)
+            v = rand_uniform_real(-100, 100);
+          references[f](x.data(), &reference, D, nullptr, nullptr, 0, 0);
+          EXPECT_DOUBLE_EQ(functions[f]->fitness(x), reference)
+              << functions[f]->get_name() << " " << DE::SIMD::name(isa);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(SIMD, same_values_as_scalar_loops) {
+  using Function = DE::Problem::CECFunction<double>;
+  for (const std::size_t D : {7, 10, 13, 30, 50, 100}) {
+    std::vector<std::unique_ptr<Function>> functions;
+    functions.emplace_back(new DE::Problem::RastriginFunction<double>(D));
+    functions.emplace_back(
+        new DE::Problem::RastriginNonContinuousRotatedFunction<double>(D));
+    functions.emplace_back(
+        new DE::Problem::LunacekBiRastriginFunction<double>(D, false));
+    functions.emplace_back(new DE::Problem::LevyFunction<double>(D));
+    functions.emplace_back(new DE::Problem::SchwefelFunction<double>(D));
+    functions.emplace_back(new DE::Problem::AckleyFunction<double>(D));
+    functions.emplace_back(new DE::Problem::GriewankFunction<double>(D));
+    functions.emplace_back(
+        new DE::Problem::ExpandedGriewankPlusRosenbrock<double>(D));
+    std::vector<double> x(D);
+    for (std::size_t test = 0; test < 20; ++test) {
+      for (auto& v : x)
+        v = rand_uniform_real(-100, 100);
+      for (const auto& f : functions) {
+        DE::SIMD::set_instruction_set(InstructionSet::scalar);
+        const double expected = f->fitness(x);
+        for (auto isa : instruction_sets()) {
+          DE::SIMD::set_instruction_set(isa);
+          EXPECT_DOUBLE_EQ(f->fitness(x), expected)
+              << f->get_name() << " " << DE::SIMD::name(isa);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(SIMD, transform_same_as_row_by_column) {
+  for (const std::size_t D : {1, 7, 10, 13, 30, 50, 100}) {
+    DE::Matrix<double> rotation(D, D);
+    std::vector<double> x(D), shift(D), expected(D), y(D);
+    for (std::size_t j = 0; j < D; ++j) {
+      x[j] = rand_uniform_real(-100, 100);
+      shift[j] = rand_uniform_real(-80, 80);
+      for (std::size_t i = 0; i < D; ++i)
+        rotation[j][i] = rand_uniform_real(-1, 1);
+    }
+    for (std::size_t i = 0; i < D; ++i) {
+      expected[i] = 0;
+      for (std::size_t j = 0; j < D; ++j)
+        expected[i] += (x[j] - shift[j]) * 0.5 * rotation[j][i];
+    }
+    for (auto isa : instruction_sets()) {
+      DE::SIMD::set_instruction_set(isa);
+      DE::SIMD::kernels().transform(x.data(), shift.data(), 0.5,
+                                    rotation.data(), rotation.stride(), D,
+                                    y.data());
+      for (std::size_t i = 0; i < D; ++i)
+        EXPECT_EQ(y[i], expected[i]) << D << " " << DE::SIMD::name(isa);
+    }
+  }
+}
+
+TEST_F(SIMD, rotate_batch_same_as_transform) {
+  for (const std::size_t D : {1, 7, 13, 30, 50, 100}) {
+    DE::Matrix<double> rotation(D, D), x(9, D), y(9, D);
+    std::vector<double> expected(D);
+    for (std::size_t j = 0; j < D; ++j)
+      for (std::size_t i = 0; i < D; ++i)
+        rotation[j][i] = rand_uniform_real(-1, 1);
+    for (std::size_t r = 0; r < x.rows(); ++r)
+      for (std::size_t j = 0; j < D; ++j)
+        x[r][j] = rand_uniform_real(-100, 100);
+    for (auto isa : instruction_sets()) {
+      DE::SIMD::set_instruction_set(isa);
+      const auto& kernels = DE::SIMD::kernels();
+      for (const std::size_t rows : {1, 4, 9}) {
+        kernels.rotate_batch(x.data(), x.stride(), rows, rotation.data(),
+                             rotation.stride(), D, y.data(), y.stride());
+        for (std::size_t r = 0; r < rows; ++r) {
+          kernels.transform(x[r].data(), nullptr, 1.0, rotation.data(),
+                            rotation.stride(), D, expected.data());
+          for (std::size_t i = 0; i < D; ++i)
+            EXPECT_EQ(y[r][i], expected[i])
+                << D << " " << rows << " " << DE::SIMD::name(isa);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
@@ -28,59 +28,60 @@ void initialize_single_function(
     const std::size_t D) {
   switch (num) {
     case 1:
-      function.reset(new DE::Problem::CigarFunction(D));
+      function.reset(new DE::Problem::CigarFunction<double>(D));
       break;
     case 2:
-      function.reset(new DE::Problem::SumOfDifferentPowerFunction(D));
+      function.reset(new DE::Problem::SumOfDifferentPowerFunction<double>(D));
       break;
     case 3:
-      function.reset(new DE::Problem::ZakharovFunction(D));
+      function.reset(new DE::Problem::ZakharovFunction<double>(D));
       break;
     case 4:
-      function.reset(new DE::Problem::RosenbrockFunction(D));
+      function.reset(new DE::Problem::RosenbrockFunction<double>(D));
       break;
     case 5:
-      function.reset(new DE::Problem::RastriginFunction(D));
+      function.reset(new DE::Problem::RastriginFunction<double>(D));
       break;
     case 6:
-      function.reset(new DE::Problem::SchafferFunction(D));
+      function.reset(new DE::Problem::SchafferFunction<double>(D));
       break;
     // cases 7, 8 have built-in shifts and rotations
     case 9:
-      function.reset(new DE::Problem::LevyFunction(D));
+      function.reset(new DE::Problem::LevyFunction<double>(D));
       break;
     case 10:
-      function.reset(new DE::Problem::SchwefelFunction(D));
+      function.reset(new DE::Problem::SchwefelFunction<double>(D));
       break;
     case 11:
-      function.reset(new DE::Problem::HighConditionedElliptic(D));
+      function.reset(new DE::Problem::HighConditionedElliptic<double>(D));
       break;
     case 12:
-      function.reset(new DE::Problem::DiscusFunction(D));
+      function.reset(new DE::Problem::DiscusFunction<double>(D));
       break;
     case 13:
-      function.reset(new DE::Problem::AckleyFunction(D));
+      function.reset(new DE::Problem::AckleyFunction<double>(D));
       break;
     case 14:
-      function.reset(new DE::Problem::WeierstrassFunction(D));
+      function.reset(new DE::Problem::WeierstrassFunction<double>(D));
       break;
     case 15:
-      function.reset(new DE::Problem::GriewankFunction(D));
+      function.reset(new DE::Problem::GriewankFunction<double>(D));
       break;
     case 16:
-      function.reset(new DE::Problem::KatsuuraFunction(D));
+      function.reset(new DE::Problem::KatsuuraFunction<double>(D));
       break;
     case 17:
-      function.reset(new DE::Problem::HappyCatFunction(D));
+      function.reset(new DE::Problem::HappyCatFunction<double>(D));
       break;
     case 18:
-      function.reset(new DE::Problem::HGBatFunction(D));
+      function.reset(new DE::Problem::HGBatFunction<double>(D));
       break;
     case 19:
-      function.reset(new DE::Problem::ExpandedGriewankPlusRosenbrock(D));
+      function.reset(
+          new DE::Problem::ExpandedGriewankPlusRosenbrock<double>(D));
       break;
     case 20:
-      function.reset(new DE::Problem::SchafferF7Function(D));
+      function.reset(new DE::Problem::SchafferF7Function<double>(D));
       break;
   }
 }
@@ -176,9 +177,10 @@ TEST_F(SimpleFunctions, Out_of_bounds) {
   std::unique_ptr<DE::Problem::CECFunction<double>> function;
   for (const auto& i : valid_indices) {
     initialize_single_function(function, i, 150);
-    ASSERT_DEATH(function->evaluate({0, 0}), ".*chromosome.size\\(\\) == D_.*");
+    ASSERT_DEATH(function->evaluate({0, 0}),
+                 ".*chromosome.size\\(\\) == this->D_.*");
     ASSERT_DEATH(function->evaluate({0, 0, 0, 0, 0, 0}),
-                 ".*chromosome.size\\(\\) == D_.*");
+                 ".*chromosome.size\\(\\) == this->D_.*");
   }
 }
 
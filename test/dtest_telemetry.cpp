@@ -0,0 +1,188 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "problem/griewank.hpp"
+#include "algorithm/shade.hpp"
+#include "algorithm/degl.hpp"
+#include "ring_buffer.hpp"
+#include "telemetry.hpp"
+
+namespace {
+
+/*! Keeps every record, in the thread that runs the optimizer */
+class Recorder : public DE::GenerationObserver {
+ public:
+  void on_generation(const DE::GenerationRecord& record) override {
+    records.push_back(record);
+  }
+
+  std::vector<DE::GenerationRecord> records;
+};
+
+std::shared_ptr<DE::Problem::GriewankFunction<double>> griewank(
+    const std::size_t D) {
+  return std::make_shared<DE::Problem::GriewankFunction<double>>(D);
+}
+
+TEST(Telemetry, ring_buffer_is_fifo_and_bounded) {
+  DE::RingBuffer<int> buffer(4);
+  int value = -1;
+  EXPECT_FALSE(buffer.pop(value));
+  for (int i = 0; i < 4; ++i)
+    EXPECT_TRUE(buffer.push(i));
+  EXPECT_FALSE(buffer.push(4));
+  // Wraps around
+  for (int round = 0; round < 3; ++round)
+    for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(buffer.pop(value));
+      EXPECT_EQ(4 * round + i, value);
+      EXPECT_TRUE(buffer.push(4 * (round + 1) + i));
+    }
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(buffer.pop(value));
+    EXPECT_EQ(12 + i, value);
+  }
+  EXPECT_FALSE(buffer.pop(value));
+}
+
+TEST(Telemetry, ring_buffer_loses_nothing_across_threads) {
+  constexpr int producers = 4, values = 20000;
+  DE::RingBuffer<int> buffer(64);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+    threads.emplace_back([&buffer, p] {
+      for (int i = 0; i < values; ++i)
+        while (!buffer.push(p * values + i))
+          std::this_thread::yield();
+    });
+  std::vector<int> last(producers, -1);
+  long long sum = 0;
+  for (int received = 0; received < producers * values;) {
+    int value;
+    if (!buffer.pop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    // The values of every producer arrive in order
+    EXPECT_LT(last[value / values], value % values);
+    last[value / values] = value % values;
+    sum += value;
+    ++received;
+  }
+  for (auto& t : threads)
+    t.join();
+  const long long n = producers * values;
+  EXPECT_EQ(n * (n - 1) / 2, sum);
+}
+
+TEST(Telemetry, one_record_per_generation) {
+  constexpr std::size_t D = 10, generations = 20;
+  const auto recorder = std::make_shared<Recorder>();
+  DE::Algorithm::SHADE<double> lshade(griewank(D), true, true, nullptr, 5);
+  lshade.set_observer(recorder);
+  lshade.evolve_population(generations);
+
+  ASSERT_EQ(generations, recorder->records.size());
+  for (std::size_t g = 0; g < generations; ++g) {
+    const auto& r = recorder->records[g];
+    EXPECT_EQ(5u, r.run);
+    EXPECT_EQ(g + 1, r.generation);
+    EXPECT_LE(r.successes, 18 * D);
+    EXPECT_LE(r.archive_size, r.archive_capacity);
+    EXPECT_LE(r.best_fitness, r.mean_fitness);
+    EXPECT_GT(r.diversity, 0.0);
+    EXPECT_EQ(6u, r.memory_size);
+    for (std::size_t k = 0; k < r.memory_size; ++k)
+      EXPECT_GT(r.memory_F[k], 0.0f);
+    if (g > 0) {
+      const auto& previous = recorder->records[g - 1];
+      EXPECT_EQ(previous.evaluations + previous.population_size,
+                r.evaluations);
+      EXPECT_LE(r.population_size, previous.population_size);
+      EXPECT_LE(r.best_fitness, previous.best_fitness);
+      EXPECT_GE(r.elapsed_seconds, previous.elapsed_seconds);
+    }
+  }
+  EXPECT_EQ(18 * D, recorder->records.front().population_size);
+  EXPECT_LT(recorder->records.back().population_size, 18 * D);
+  EXPECT_EQ(lshade.get_best().best_fitness,
+            recorder->records.back().best_fitness);
+  EXPECT_EQ(lshade.get_evaluations(), recorder->records.back().evaluations);
+}
+
+TEST(Telemetry, degl_has_no_archive_nor_memory) {
+  constexpr std::size_t D = 10;
+  const auto recorder = std::make_shared<Recorder>();
+  DE::Algorithm::DEGL<double> degl(griewank(D), true, nullptr, 5);
+  degl.set_observer(recorder);
+  degl.evolve_population(10);
+
+  ASSERT_EQ(10u, recorder->records.size());
+  std::size_t successes = 0;
+  for (const auto& r : recorder->records) {
+    EXPECT_EQ(10 * D, r.population_size);
+    EXPECT_EQ(0u, r.archive_capacity);
+    EXPECT_EQ(0u, r.memory_size);
+    successes += r.successes;
+  }
+  EXPECT_GT(successes, 0u);
+}
+
+TEST(Telemetry, observing_does_not_change_the_run) {
+  constexpr std::size_t D = 10;
+  DE::Algorithm::SHADE<double> plain(griewank(D), true, true, nullptr, 8);
+  DE::Algorithm::SHADE<double> observed(griewank(D), true, true, nullptr, 8);
+  observed.set_observer(std::make_shared<Recorder>());
+  plain.evolve_population(30);
+  observed.evolve_population(30);
+  EXPECT_EQ(plain.get_best().best_chromosome,
+            observed.get_best().best_chromosome);
+}
+
+TEST(Telemetry, async_observer_delivers_in_order) {
+  constexpr std::size_t D = 10, generations = 50;
+  std::vector<DE::GenerationRecord> delivered;
+  std::thread::id sink_thread;
+  std::size_t dropped;
+  {
+    const auto observer = std::make_shared<DE::AsyncObserver>(
+        [&](const DE::GenerationRecord& r) {
+          sink_thread = std::this_thread::get_id();
+          delivered.push_back(r);
+        },
+        64);
+    DE::Algorithm::DEGL<double> degl(griewank(D), true, nullptr, 3);
+    degl.set_observer(observer);
+    degl.evolve_population(generations);
+    dropped = observer->dropped();
+  }  // Drained and joined here
+  EXPECT_NE(std::this_thread::get_id(), sink_thread);
+  ASSERT_EQ(generations, delivered.size() + dropped);
+  for (std::size_t i = 1; i < delivered.size(); ++i)
+    EXPECT_LT(delivered[i - 1].generation, delivered[i].generation);
+}
+
+TEST(Telemetry, csv_writer) {
+  std::ostringstream out;
+  DE::CsvWriter writer(out);
+  DE::GenerationRecord r;
+  r.generation = 7;
+  r.memory_size = 2;
+  r.memory_F = {0.5f, 0.25f};
+  r.memory_Cr = {1.0f, -100.0f};
+  writer(r);
+  std::istringstream in(out.str());
+  std::string header, line;
+  std::getline(in, header);
+  std::getline(in, line);
+  EXPECT_EQ(std::count(header.begin(), header.end(), ','),
+            std::count(line.begin(), line.end(), ','));
+  EXPECT_EQ("0,7,", line.substr(0, 4));
+  EXPECT_NE(std::string::npos, line.find(",0.5;0.25,1;-100"));
+}
+
+}  // namespace
@@ -14,40 +14,42 @@
 #include "test_utils.hpp"
 #include "cec17_test_func.hpp"
 
+template <class T>
 void initialize_unimodal_function(
-    std::unique_ptr<DE::Problem::CECFunction<double>>& function,
+    std::unique_ptr<DE::Problem::CECFunction<T>>& function,
     const std::size_t num,
     const std::size_t D) {
   switch (num) {
     case 1:
-      function.reset(new DE::Problem::CigarFunction(D));
+      function.reset(new DE::Problem::CigarFunction<T>(D));
       break;
     case 2:
-      function.reset(new DE::Problem::SumOfDifferentPowerFunction(D));
+      function.reset(new DE::Problem::SumOfDifferentPowerFunction<T>(D));
       break;
     case 3:
-      function.reset(new DE::Problem::ZakharovFunction(D));
+      function.reset(new DE::Problem::ZakharovFunction<T>(D));
       break;
     case 4:
-      function.reset(new DE::Problem::RosenbrockFunction(D));
+      function.reset(new DE::Problem::RosenbrockFunction<T>(D));
       break;
     case 5:
-      function.reset(new DE::Problem::RastriginFunction(D));
+      function.reset(new DE::Problem::RastriginFunction<T>(D));
       break;
     case 6:
-      function.reset(new DE::Problem::SchafferF7Function(D));
+      function.reset(new DE::Problem::SchafferF7Function<T>(D));
       break;
     case 7:
-      function.reset(new DE::Problem::LunacekBiRastriginFunction(D));
+      function.reset(new DE::Problem::LunacekBiRastriginFunction<T>(D));
       break;
     case 8:
-      function.reset(new DE::Problem::RastriginNonContinuousRotatedFunction(D));
+      function.reset(
+          new DE::Problem::RastriginNonContinuousRotatedFunction<T>(D));
       break;
     case 9:
-      function.reset(new DE::Problem::LevyFunction(D));
+      function.reset(new DE::Problem::LevyFunction<T>(D));
       break;
     case 10:
-      function.reset(new DE::Problem::SchwefelFunction(D));
+      function.reset(new DE::Problem::SchwefelFunction<T>(D));
       break;
   }
   function->parse_shift_file(shift_file(num).c_str());
@@ -74,4 +76,21 @@ TEST_F(UnimodalFunctions, same_values) {
   }
 }
 
+TEST_F(UnimodalFunctions, float_accuracy) {
+  std::unique_ptr<DE::Problem::CECFunction<float>> function;
+  double fitness;
+  for (std::size_t i = 1; i <= 10; ++i) {
+    double error = 0.0;
+    for (auto& x : x_tests) {
+      initialize_unimodal_function(function, i, x.size());
+      cec17_test_func(x.data(), &fitness, x.size(), 1, i);
+      const std::vector<float> y(x.begin(), x.end());
+      error = std::max(error,
+                       relative_error(function->fitness(y) + 100.0 * i, fitness));
+    }
+    report_accuracy(function->get_name(), error);
+    EXPECT_LT(error, float_tolerance) << function->get_name();
+  }
+}
+
 }  // namespace
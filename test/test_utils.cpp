@@ -2,7 +2,10 @@
 #include <ctime>
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <string>
+#include "gtest/gtest.h"
 #include "rand.hpp"
 #include "cec17_test_func.hpp"
 
@@ -29,6 +32,15 @@ void init_values() {
   z = new double[max_size];
 }
 
+double relative_error(const double value, const double reference) {
+  return std::abs(value - reference) / std::max(1.0, std::abs(reference));
+}
+
+void report_accuracy(const char* name, const double error) {
+  ::testing::Test::RecordProperty(name, std::to_string(error));
+  printf("[ float    ] %s: relative error %.2e\n", name, error);
+}
+
 // Shift and rotation files
 const std::string base_path = "cec-2017/";
 
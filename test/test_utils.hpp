@@ -17,4 +17,9 @@ void load_shift_data(const int nx, const int func_num);
 void load_shuffle_data(const int nx, const int cf_num, const int func_num);
 void load_bias_data(const int cf_num, const int func_num);
 
+// Single-precision functions against the double-precision reference
+constexpr double float_tolerance = 1e-4;
+double relative_error(const double value, const double reference);
+void report_accuracy(const char* name, const double error);
+
 #endif
@@ -0,0 +1,38 @@
+/*!
+ * Packs the shift, rotation and shuffle files of the CEC benchmark functions
+ * into a single binary file, which the functions then map into memory
+ * instead of parsing the text files. Kindly check README.md.
+ *
+ * Usage: pack_cec_data <data directory> [output]
+ *
+ * The output defaults to cec-2017.pack inside the data directory, where the
+ * functions look for it.
+ */
+
+#include "problem/cec_data_pack.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " <data directory> [output]"
+              << std::endl;
+    return 1;
+  }
+  std::string directory = argv[1];
+  if (!directory.empty() && directory.back() != '/')
+    directory.push_back('/');
+  const std::string output =
+      argc == 3 ? std::string(argv[2])
+                : directory + DE::Problem::CECDataPack::file_name;
+  try {
+    const std::size_t count =
+        DE::Problem::CECDataPack::create(directory, output);
+    std::cout << "Packed " << count << " files into " << output << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}